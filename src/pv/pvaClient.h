@@ -16,6 +16,8 @@
 #endif
 
 #include <list>
+#include <map>
+#include <deque>
 #include <iostream>
 #include <ostream>
 #include <sstream>
@@ -39,6 +41,7 @@
 #   undef pvaClientEpicsExportSharedSymbols
 #endif
 
+#include <epicsThread.h>
 #include <shareLib.h>
 
 namespace epics { namespace pvaClient {
@@ -58,6 +61,20 @@ typedef std::tr1::shared_ptr<PvaClientChannelStateChangeRequester> PvaClientChan
 typedef std::tr1::weak_ptr<PvaClientChannelStateChangeRequester> PvaClientChannelStateChangeRequesterWPtr;
 class PvaClientChannel;
 typedef std::tr1::shared_ptr<PvaClientChannel> PvaClientChannelPtr;
+typedef epics::pvData::shared_vector<PvaClientChannelPtr> PvaClientChannelArray;
+class PvaClientConnectLatch;
+typedef std::tr1::shared_ptr<PvaClientConnectLatch> PvaClientConnectLatchPtr;
+class PvaClientFuture;
+typedef std::tr1::shared_ptr<PvaClientFuture> PvaClientFuturePtr;
+class PvaClientFutureRequester;
+typedef std::tr1::shared_ptr<PvaClientFutureRequester> PvaClientFutureRequesterPtr;
+class PvaClientCompletionQueue;
+typedef std::tr1::shared_ptr<PvaClientCompletionQueue> PvaClientCompletionQueuePtr;
+typedef std::tr1::weak_ptr<PvaClientCompletionQueue> PvaClientCompletionQueueWPtr;
+class PvaClientExecutorTask;
+typedef std::tr1::shared_ptr<PvaClientExecutorTask> PvaClientExecutorTaskPtr;
+class PvaClientExecutor;
+typedef std::tr1::shared_ptr<PvaClientExecutor> PvaClientExecutorPtr;
 class PvaClientProcessRequester;
 typedef std::tr1::shared_ptr<PvaClientProcessRequester> PvaClientProcessRequesterPtr;
 typedef std::tr1::weak_ptr<PvaClientProcessRequester> PvaClientProcessRequesterWPtr;
@@ -68,6 +85,8 @@ typedef std::tr1::shared_ptr<PvaClientGetRequester> PvaClientGetRequesterPtr;
 typedef std::tr1::weak_ptr<PvaClientGetRequester> PvaClientGetRequesterWPtr;
 class PvaClientGet;
 typedef std::tr1::shared_ptr<PvaClientGet> PvaClientGetPtr;
+class PvaClientGetPipeline;
+typedef std::tr1::shared_ptr<PvaClientGetPipeline> PvaClientGetPipelinePtr;
 class PvaClientPutRequester;
 typedef std::tr1::shared_ptr<PvaClientPutRequester> PvaClientPutRequesterPtr;
 typedef std::tr1::weak_ptr<PvaClientPutRequester> PvaClientPutRequesterWPtr;
@@ -80,6 +99,9 @@ class PvaClientPutGet;
 typedef std::tr1::shared_ptr<PvaClientPutGet> PvaClientPutGetPtr;
 class PvaClientMonitor;
 typedef std::tr1::shared_ptr<PvaClientMonitor> PvaClientMonitorPtr;
+class PvaClientMonitorSelector;
+typedef std::tr1::shared_ptr<PvaClientMonitorSelector> PvaClientMonitorSelectorPtr;
+typedef std::tr1::weak_ptr<PvaClientMonitorSelector> PvaClientMonitorSelectorWPtr;
 class PvaClientMonitorRequester;
 typedef std::tr1::shared_ptr<PvaClientMonitorRequester> PvaClientMonitorRequesterPtr;
 typedef std::tr1::weak_ptr<PvaClientMonitorRequester> PvaClientMonitorRequesterWPtr;
@@ -92,8 +114,68 @@ typedef std::tr1::weak_ptr<PvaClientRPCRequester> PvaClientRPCRequesterWPtr;
 // following are private to pvaClient
 class PvaClientChannelCache;
 typedef std::tr1::shared_ptr<PvaClientChannelCache> PvaClientChannelCachePtr;
+class PvaClientPVRequestCache;
+typedef std::tr1::shared_ptr<PvaClientPVRequestCache> PvaClientPVRequestCachePtr;
 
 
+/**
+ * @brief Limits for a cache.
+ *
+ * PvaClient::setCacheLimits sets the limits of the channel cache and
+ * PvaClient::setRequestCacheLimits the limits of the get and put caches of each channel.
+ * A value of 0 means no limit. When a limit is exceeded the least recently used
+ * entries are evicted. Evicted objects remain valid for clients that still hold them.
+ */
+class epicsShareClass PvaClientCacheLimits
+{
+public:
+    PvaClientCacheLimits()
+    : maxEntries(0),
+      maxBytes(0),
+      maxIdleTime(0.0)
+    {}
+    /** Maximum number of entries in the cache.
+     */
+    size_t maxEntries;
+    /** Maximum number of data bytes held by the cache.
+     */
+    size_t maxBytes;
+    /** Number of seconds an entry can be unused before it is evicted.
+     */
+    double maxIdleTime;
+};
+
+/**
+ * @brief Counters for a cache.
+ *
+ */
+class epicsShareClass PvaClientCacheStats
+{
+public:
+    PvaClientCacheStats()
+    : entries(0),
+      bytes(0),
+      hits(0),
+      misses(0),
+      evictions(0)
+    {}
+    /** Number of cached entries.
+     */
+    size_t entries;
+    /** Estimated number of data bytes held by the cached entries.
+     */
+    size_t bytes;
+    /** Number of lookups that found an entry.
+     */
+    size_t hits;
+    /** Number of lookups that did not find an entry.
+     */
+    size_t misses;
+    /** Number of entries evicted because a limit was exceeded.
+     */
+    size_t evictions;
+};
+
 /**
  * @brief  pvaClient is a synchronous wrapper for the pvAccess API, which is a callback based API.
  *
@@ -131,6 +213,9 @@ public:
         epics::pvData::MessageType messageType);
     /** @brief Get a cached channel or create and connect to a new channel.
      *
+     * This can be called concurrently from multiple threads.
+     * The cache is keyed by (channelName,providerName) and split into
+     * independently locked stripes so that lookups do not contend.
      * @param channelName The channelName.
      * @param providerName The providerName.
      * @param timeOut The number of seconds to wait for connection. 0.0 means forever.
@@ -150,6 +235,33 @@ public:
     PvaClientChannelPtr createChannel(
        std::string const & channelName,
        std::string const & providerName = "pva");
+    /** @brief Get cached channels or create and connect to many new channels at once.
+     *
+     * A connect request is issued for every channel that is not cached
+     * before waiting, so the total time is bounded by the slowest channel
+     * rather than the sum over all channels.
+     * Channels that connect are added to the cache.
+     * @param channelNames The channel names.
+     * @param pvaClientChannels Set to the channels, in the same order as channelNames.
+     * A channel that did not connect is still returned but is not cached.
+     * @param providerName The providerName.
+     * @param timeOut The number of seconds to wait for all channels to connect. 0.0 means forever.
+     * @return The status of each channel, in the same order as channelNames.
+     */
+    std::vector<epics::pvData::Status> channels(
+        epics::pvData::shared_vector<const std::string> const & channelNames,
+        PvaClientChannelArray & pvaClientChannels,
+        std::string const & providerName = "pva",
+        double timeOut = 5.0);
+    /** @brief Get a parsed pvRequest for a request string.
+     *
+     * Each distinct request string is parsed once by createRequest as implemented by pvData.
+     * The result is immutable and shared by every caller that passes the same string.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @return The pvRequest.
+     * @throw runtime_error if the request is not valid.
+     */
+    epics::pvData::PVStructurePtr createRequest(std::string const & request);
 
     /** @brief Set a requester.
      *
@@ -173,6 +285,70 @@ public:
      /** @brief Get the number of cached channels.
      */
     size_t cacheSize();
+    /** @brief Set limits for the channel cache.
+     *
+     * The default is no limits, i. e. the cache grows forever.
+     * maxBytes is the total data held by the get and put caches of all cached channels,
+     * so it bounds the memory of all the caches together.
+     * While a limit is set a timer thread checks the caches once a second.
+     * The size of a cached get or put is only estimated when a maxBytes is set.
+     * It is estimated when the get or put is created and again the first time
+     * it is used after each check, so arrays that change size are followed.
+     * @param limits The limits.
+     */
+    void setCacheLimits(PvaClientCacheLimits const & limits);
+    /** @brief Get the channel cache limits.
+     *
+     * @return The limits.
+     */
+    PvaClientCacheLimits getCacheLimits();
+    /** @brief Set limits for the get and put caches of each channel.
+     *
+     * The default is no limits.
+     * The limits apply to each cache on its own, and each channel has two caches,
+     * so maxBytes here bounds one cache, not the total. Use setCacheLimits for that.
+     * @param limits The limits.
+     */
+    void setRequestCacheLimits(PvaClientCacheLimits const & limits);
+    /** @brief Get the limits of the get and put caches of each channel.
+     *
+     * @return The limits.
+     */
+    PvaClientCacheLimits getRequestCacheLimits();
+    /** @brief Get the counters for the channel cache.
+     *
+     * @return The counters.
+     */
+    PvaClientCacheStats getCacheStats();
+    /** @brief Set the executor that calls the PvaClient*Requester callbacks.
+     *
+     * The default is no executor, i. e. the callbacks are called by the pvAccess threads.
+     * This affects the callbacks of all channels, including existing channels.
+     * @param executor The executor. An empty pointer restores the default.
+     */
+    void setExecutor(PvaClientExecutorPtr const & executor);
+    /** @brief Get the executor.
+     *
+     * @return The executor. This is empty if no executor is set.
+     */
+    PvaClientExecutorPtr getExecutor();
+    /** @brief Set how PvaClientPutData keeps track of the fields that change.
+     *
+     * The default, true, installs a PostHandler on every field of the put structure,
+     * so that any write to a field sets its bit in the changed BitSet.
+     * If false no PostHandler is installed.
+     * The put methods of PvaClientPutData and parse still set the bits of the fields they write,
+     * but a client that writes to the PVStructure directly must set the bits itself.
+     * This saves one object for each field of each put and putGet.
+     * It affects the puts and putGets that connect after the call.
+     * @param value true or false
+     */
+    void setPutPostHandlers(bool value);
+    /** @brief Does PvaClientPutData install a PostHandler on every field?
+     *
+     * @return true or false
+     */
+    bool getPutPostHandlers();
     /** @brief Should debug info be shown?
      *
      * @param value true or false
@@ -186,7 +362,10 @@ public:
 private:
     PvaClient(std::string const & providerNames);
     PvaClientChannelCachePtr pvaClientChannelCache;
+    PvaClientPVRequestCachePtr pvaClientPVRequestCache;
     epics::pvData::Requester::weak_pointer requester;
+    PvaClientExecutorPtr executor;
+    bool putPostHandlers;
     bool pvaStarted;
     bool caStarted;
     epics::pvData::Mutex mutex;
@@ -198,6 +377,8 @@ class PvaClientGetCache;
 typedef std::tr1::shared_ptr<PvaClientGetCache> PvaClientGetCachePtr;
 class PvaClientPutCache;
 typedef std::tr1::shared_ptr<PvaClientPutCache> PvaClientPutCachePtr;
+class PvaClientReadCache;
+typedef std::tr1::shared_ptr<PvaClientReadCache> PvaClientReadCachePtr;
 
 
 /**
@@ -223,6 +404,572 @@ public:
     virtual void channelStateChange(PvaClientChannelPtr const & channel, bool isConnected) = 0;
 };
 
+/**
+ * @brief A countdown latch used to wait for a group of channels to connect.
+ *
+ */
+class epicsShareClass PvaClientConnectLatch
+{
+public:
+    POINTER_DEFINITIONS(PvaClientConnectLatch);
+    /** @brief Create a latch.
+     *
+     * @param count The number of countDown calls before wait returns.
+     * @return The interface.
+     */
+    static PvaClientConnectLatchPtr create(size_t count);
+    /**
+     * @brief Destructor
+     */
+    ~PvaClientConnectLatch();
+    /** @brief Decrement the count and wake waiters when it reaches zero.
+     */
+    void countDown();
+    /** @brief Get the remaining count.
+     *
+     * @return The count.
+     */
+    size_t getCount();
+    /** @brief Wait until the count reaches zero or for timeout.
+     *
+     * @param timeout The time in seconds to wait. A value of 0 means forever.
+     * @return (false,true) if count (is not, is) zero.
+     */
+    bool wait(double timeout = 5.0);
+private:
+    PvaClientConnectLatch(size_t count);
+
+    size_t count;
+    epics::pvData::Mutex mutex;
+    epics::pvData::Event event;
+};
+
+/**
+ * @brief A callback for completion of a PvaClientFuture.
+ *
+ */
+class epicsShareClass PvaClientFutureRequester
+{
+public:
+    POINTER_DEFINITIONS(PvaClientFutureRequester);
+    virtual ~PvaClientFutureRequester() {}
+    /** @brief The future is complete.
+     *
+     * <b>Warning</b> This is called by the thread that completed the request
+     * and a call to a method that blocks should not be made by this method.
+     * @param future The future.
+     */
+    virtual void futureDone(PvaClientFuturePtr const & future) = 0;
+};
+
+/**
+ * @brief A queue that delivers the completions of many futures to a pool of threads.
+ *
+ * Completions are pushed onto a lock free multiple producer single consumer list
+ * by the threads that complete the futures, i. e. the pvAccess callback threads.
+ * The pool threads take turns removing completions and call the
+ * PvaClientFutureRequester::futureDone of each future that is bound to the queue.
+ */
+class epicsShareClass PvaClientCompletionQueue :
+    private epicsThreadRunable
+{
+public:
+    POINTER_DEFINITIONS(PvaClientCompletionQueue);
+    /** @brief Create a queue and start its threads.
+     *
+     * @param numberThreads The number of threads that call futureDone.
+     * @return The interface.
+     */
+    static PvaClientCompletionQueuePtr create(size_t numberThreads = 1);
+    /**
+     * @brief Destructor
+     *
+     * Stops the threads after the pending completions are delivered.
+     * The last reference may be released by a futureDone that a thread of the queue calls.
+     */
+    ~PvaClientCompletionQueue();
+    /** @brief Get the number of threads.
+     *
+     * @return The number.
+     */
+    size_t getNumberThreads();
+    /** @brief Get the number of completions not yet delivered.
+     *
+     * @return The number.
+     */
+    size_t getPending();
+private:
+    struct Node;
+    PvaClientCompletionQueue(size_t numberThreads);
+    void push(
+        PvaClientFuturePtr const & future,
+        std::vector<PvaClientFutureRequesterPtr> const & requesters);
+    Node * pop();
+    void deliver(Node * node);
+    virtual void run();
+
+    PvaClientCompletionQueueWPtr self;  // held while futureDone is called
+    void * head;          // Node *, pushed by any thread
+    Node * tail;          // removed by one pool thread at a time
+    Node * stub;
+    size_t pending;
+    size_t waiting;
+    size_t stopping;
+    epics::pvData::Mutex consumerMutex;
+    epics::pvData::Event waitForWork;
+    std::vector<std::tr1::shared_ptr<epicsThread> > threads;
+    std::vector<bool *> threadDestroyed;  // set by run; the destructor marks its own thread
+    friend class PvaClientFuture;
+};
+
+/**
+ * @brief Work that is run by a PvaClientExecutor.
+ *
+ */
+class epicsShareClass PvaClientExecutorTask
+{
+public:
+    POINTER_DEFINITIONS(PvaClientExecutorTask);
+    virtual ~PvaClientExecutorTask() {}
+    /** @brief Do the work.
+     *
+     * This is called by a thread of the executor.
+     */
+    virtual void run() = 0;
+};
+
+/**
+ * @brief A task that calls a requester method with no arguments.
+ *
+ */
+template<typename Requester,typename Method>
+class PvaClientExecutorCall0 : public PvaClientExecutorTask
+{
+public:
+    PvaClientExecutorCall0(Requester const & requester,Method method)
+    : requester(requester),method(method) {}
+    virtual void run() { ((*requester).*method)(); }
+private:
+    Requester requester;
+    Method method;
+};
+
+/**
+ * @brief A task that calls a requester method with one argument.
+ *
+ */
+template<typename Requester,typename Method,typename Arg1>
+class PvaClientExecutorCall1 : public PvaClientExecutorTask
+{
+public:
+    PvaClientExecutorCall1(Requester const & requester,Method method,Arg1 const & arg1)
+    : requester(requester),method(method),arg1(arg1) {}
+    virtual void run() { ((*requester).*method)(arg1); }
+private:
+    Requester requester;
+    Method method;
+    Arg1 arg1;
+};
+
+/**
+ * @brief A task that calls a requester method with two arguments.
+ *
+ */
+template<typename Requester,typename Method,typename Arg1,typename Arg2>
+class PvaClientExecutorCall2 : public PvaClientExecutorTask
+{
+public:
+    PvaClientExecutorCall2(
+        Requester const & requester,Method method,Arg1 const & arg1,Arg2 const & arg2)
+    : requester(requester),method(method),arg1(arg1),arg2(arg2) {}
+    virtual void run() { ((*requester).*method)(arg1,arg2); }
+private:
+    Requester requester;
+    Method method;
+    Arg1 arg1;
+    Arg2 arg2;
+};
+
+/**
+ * @brief A task that calls a requester method with three arguments.
+ *
+ */
+template<typename Requester,typename Method,typename Arg1,typename Arg2,typename Arg3>
+class PvaClientExecutorCall3 : public PvaClientExecutorTask
+{
+public:
+    PvaClientExecutorCall3(
+        Requester const & requester,Method method,
+        Arg1 const & arg1,Arg2 const & arg2,Arg3 const & arg3)
+    : requester(requester),method(method),arg1(arg1),arg2(arg2),arg3(arg3) {}
+    virtual void run() { ((*requester).*method)(arg1,arg2,arg3); }
+private:
+    Requester requester;
+    Method method;
+    Arg1 arg1;
+    Arg2 arg2;
+    Arg3 arg3;
+};
+
+/**
+ * @brief Counters for a PvaClientExecutor.
+ *
+ * Times are in seconds.
+ */
+class epicsShareClass PvaClientExecutorStats
+{
+public:
+    PvaClientExecutorStats()
+    : queued(0),
+      maxQueued(0),
+      executed(0),
+      overflowed(0),
+      totalWaitTime(0.0),
+      maxWaitTime(0.0),
+      totalRunTime(0.0),
+      maxRunTime(0.0)
+    {}
+    /** Number of tasks waiting to run.
+     */
+    size_t queued;
+    /** Largest number of tasks that have been waiting at the same time.
+     */
+    size_t maxQueued;
+    /** Number of tasks that have run.
+     */
+    size_t executed;
+    /** Number of tasks queued while maxQueued tasks were already waiting.
+     */
+    size_t overflowed;
+    /** Total time tasks waited in the queue.
+     */
+    double totalWaitTime;
+    /** Longest time a task waited in the queue.
+     */
+    double maxWaitTime;
+    /** Total time spent in PvaClientExecutorTask::run.
+     */
+    double totalRunTime;
+    /** Longest time spent in a single PvaClientExecutorTask::run.
+     */
+    double maxRunTime;
+};
+
+/**
+ * @brief A pool of threads that calls the PvaClient*Requester callbacks.
+ *
+ * By default the callbacks are called by the pvAccess network threads,
+ * so a slow callback delays every channel that shares the same connection.
+ * When an executor is given to PvaClient::setExecutor the callbacks are
+ * queued instead and called by the threads of the executor.
+ * Tasks that have the same strand, i. e. the callbacks of one channel,
+ * are run one at a time in the order they were queued.
+ */
+class epicsShareClass PvaClientExecutor :
+    private epicsThreadRunable
+{
+public:
+    POINTER_DEFINITIONS(PvaClientExecutor);
+    /** @brief Create an executor and start its threads.
+     *
+     * @param numberThreads The number of threads.
+     * @param maxQueued The number of queued tasks above which execute counts
+     * an overflow. 0 means no limit.
+     * execute never waits, because it is called by the pvAccess network threads;
+     * a task that arrives when the queue is full is still queued.
+     * @param priority The epicsThread priority of the threads.
+     * @return The interface.
+     */
+    static PvaClientExecutorPtr create(
+        size_t numberThreads = 1,
+        size_t maxQueued = 10000,
+        unsigned int priority = epicsThreadPriorityMedium);
+    /**
+     * @brief Destructor
+     *
+     * Stops the threads after the queued tasks have run.
+     * The last reference must not be released by a task of the executor.
+     */
+    ~PvaClientExecutor();
+    /** @brief Queue a task.
+     *
+     * @param strand Tasks with the same strand are run in order, one at a time.
+     * @param task The task.
+     */
+    void execute(void const * strand,PvaClientExecutorTaskPtr const & task);
+    /** @brief Get the number of threads.
+     *
+     * @return The number.
+     */
+    size_t getNumberThreads();
+    /** @brief Get the maximum number of queued tasks.
+     *
+     * @return The number.
+     */
+    size_t getMaxQueued();
+    /** @brief Get the counters.
+     *
+     * @return The counters.
+     */
+    PvaClientExecutorStats getStats();
+    /** @brief Call a requester method with the executor of a client.
+     *
+     * If the client has an executor the call is queued, else it is made now.
+     * @param pvaClient The client.
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     */
+    template<typename Requester,typename Method>
+    static void dispatch(PvaClient::weak_pointer const & pvaClient,
+        void const * strand,Requester const & requester,Method method)
+    {
+        PvaClientExecutorPtr executor(getExecutor(pvaClient));
+        if(executor) {
+            executor->call(strand,requester,method);
+        } else {
+            ((*requester).*method)();
+        }
+    }
+    /** @brief Call a requester method with the executor of a client.
+     *
+     * @param pvaClient The client.
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The argument.
+     */
+    template<typename Requester,typename Method,typename Arg1>
+    static void dispatch(PvaClient::weak_pointer const & pvaClient,
+        void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1)
+    {
+        PvaClientExecutorPtr executor(getExecutor(pvaClient));
+        if(executor) {
+            executor->call(strand,requester,method,arg1);
+        } else {
+            ((*requester).*method)(arg1);
+        }
+    }
+    /** @brief Call a requester method with the executor of a client.
+     *
+     * @param pvaClient The client.
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The first argument.
+     * @param arg2 The second argument.
+     */
+    template<typename Requester,typename Method,typename Arg1,typename Arg2>
+    static void dispatch(PvaClient::weak_pointer const & pvaClient,
+        void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1,Arg2 const & arg2)
+    {
+        PvaClientExecutorPtr executor(getExecutor(pvaClient));
+        if(executor) {
+            executor->call(strand,requester,method,arg1,arg2);
+        } else {
+            ((*requester).*method)(arg1,arg2);
+        }
+    }
+    /** @brief Call a requester method with the executor of a client.
+     *
+     * @param pvaClient The client.
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The first argument.
+     * @param arg2 The second argument.
+     * @param arg3 The third argument.
+     */
+    template<typename Requester,typename Method,typename Arg1,typename Arg2,typename Arg3>
+    static void dispatch(PvaClient::weak_pointer const & pvaClient,
+        void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1,Arg2 const & arg2,Arg3 const & arg3)
+    {
+        PvaClientExecutorPtr executor(getExecutor(pvaClient));
+        if(executor) {
+            executor->call(strand,requester,method,arg1,arg2,arg3);
+        } else {
+            ((*requester).*method)(arg1,arg2,arg3);
+        }
+    }
+    /** @brief Queue a call of requester method.
+     *
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     */
+    template<typename Requester,typename Method>
+    void call(void const * strand,Requester const & requester,Method method)
+    {
+        execute(strand,PvaClientExecutorTaskPtr(
+            new PvaClientExecutorCall0<Requester,Method>(requester,method)));
+    }
+    /** @brief Queue a call of requester method.
+     *
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The argument.
+     */
+    template<typename Requester,typename Method,typename Arg1>
+    void call(void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1)
+    {
+        execute(strand,PvaClientExecutorTaskPtr(
+            new PvaClientExecutorCall1<Requester,Method,Arg1>(requester,method,arg1)));
+    }
+    /** @brief Queue a call of requester method.
+     *
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The first argument.
+     * @param arg2 The second argument.
+     */
+    template<typename Requester,typename Method,typename Arg1,typename Arg2>
+    void call(void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1,Arg2 const & arg2)
+    {
+        execute(strand,PvaClientExecutorTaskPtr(
+            new PvaClientExecutorCall2<Requester,Method,Arg1,Arg2>(
+                requester,method,arg1,arg2)));
+    }
+    /** @brief Queue a call of requester method.
+     *
+     * @param strand The strand.
+     * @param requester The requester.
+     * @param method The method.
+     * @param arg1 The first argument.
+     * @param arg2 The second argument.
+     * @param arg3 The third argument.
+     */
+    template<typename Requester,typename Method,typename Arg1,typename Arg2,typename Arg3>
+    void call(void const * strand,Requester const & requester,Method method,
+        Arg1 const & arg1,Arg2 const & arg2,Arg3 const & arg3)
+    {
+        execute(strand,PvaClientExecutorTaskPtr(
+            new PvaClientExecutorCall3<Requester,Method,Arg1,Arg2,Arg3>(
+                requester,method,arg1,arg2,arg3)));
+    }
+private:
+    struct Strand;
+    PvaClientExecutor(size_t numberThreads,size_t maxQueued,unsigned int priority);
+    virtual void run();
+    static PvaClientExecutorPtr getExecutor(PvaClient::weak_pointer const & pvaClient);
+
+    typedef std::map<void const *,Strand *> StrandMap;
+    size_t maxQueued;
+    StrandMap strandMap;
+    std::deque<Strand *> ready;       // strands with tasks and no running task
+    bool stopping;
+    PvaClientExecutorStats stats;
+    epics::pvData::Mutex mutex;
+    epics::pvData::Event waitForWork;
+    std::vector<std::tr1::shared_ptr<epicsThread> > threads;
+};
+
+/**
+ * @brief The result of an asynchronous get, put, putGet, process, or rpc request.
+ *
+ * The future keeps the object that issued the request alive until the request completes.
+ */
+class epicsShareClass PvaClientFuture :
+    public std::tr1::enable_shared_from_this<PvaClientFuture>
+{
+public:
+    POINTER_DEFINITIONS(PvaClientFuture);
+    /** @brief Create a future that is not complete.
+     *
+     * @return The interface.
+     */
+    static PvaClientFuturePtr create();
+    /** @brief Create a future that completes when all the futures complete.
+     *
+     * The status is the first status that is not OK or else OK.
+     * @param futures The futures.
+     * @return The interface.
+     */
+    static PvaClientFuturePtr whenAll(std::vector<PvaClientFuturePtr> const & futures);
+    /**
+     * @brief Destructor
+     */
+    ~PvaClientFuture();
+    /** @brief Is the request complete?
+     *
+     * @return (false,true) if (not complete, complete).
+     */
+    bool isDone();
+    /** @brief Wait until the request completes or for timeout.
+     *
+     * @param timeout The time in seconds to wait. A value of 0 means forever.
+     * @return (false,true) if (not complete, complete).
+     */
+    bool wait(double timeout = 0.0);
+    /** @brief Add a callback that is called when the request completes.
+     *
+     * If the request is already complete the callback is called immediately.
+     * @param requester The callback.
+     */
+    void then(PvaClientFutureRequesterPtr const & requester);
+    /** @brief Deliver the callbacks added by then on the threads of a completion queue.
+     *
+     * By default the callbacks are called by the thread that completes the request.
+     * The future does not keep the queue alive; if the queue is destroyed
+     * the callbacks are again called by the thread that completes the request.
+     * @param queue The completion queue.
+     */
+    void bind(PvaClientCompletionQueuePtr const & queue);
+    /** @brief Get the status of the request.
+     *
+     * @return The status. This is an error if the request is not complete.
+     */
+    epics::pvData::Status getStatus();
+    /** @brief Get the data for a get or putGet request.
+     *
+     * @return The interface or null.
+     */
+    PvaClientGetDataPtr getGetData();
+    /** @brief Get the data for a put or putGet request.
+     *
+     * @return The interface or null.
+     */
+    PvaClientPutDataPtr getPutData();
+    /** @brief Get the response for an rpc request.
+     *
+     * @return The response or null.
+     */
+    epics::pvData::PVStructurePtr getPVStructure();
+private:
+    PvaClientFuture();
+    void setOwner(std::tr1::shared_ptr<void> const & owner);
+    void complete(
+        epics::pvData::Status const & status,
+        PvaClientGetDataPtr const & getData = PvaClientGetDataPtr(),
+        PvaClientPutDataPtr const & putData = PvaClientPutDataPtr(),
+        epics::pvData::PVStructurePtr const & pvStructure = epics::pvData::PVStructurePtr());
+
+    epics::pvData::Mutex mutex;
+    epics::pvData::EventPtr waitForDone;    // only created if a thread waits
+    PvaClientCompletionQueueWPtr queue;
+    bool done;
+    epics::pvData::Status status;
+    PvaClientGetDataPtr getData;
+    PvaClientPutDataPtr putData;
+    epics::pvData::PVStructurePtr pvStructure;
+    std::tr1::shared_ptr<void> owner;
+    std::vector<PvaClientFutureRequesterPtr> requesters;
+    friend class PvaClientFutureWhenAll;
+    friend class PvaClientChannel;
+    friend class PvaClientMonitor;
+    friend class PvaClientGet;
+    friend class PvaClientPut;
+    friend class PvaClientPutGet;
+    friend class PvaClientProcess;
+    friend class PvaClientRPC;
+};
+
 /**
  * @brief An easy to use alternative to directly calling the Channel methods of pvAccess.
  *
@@ -243,6 +990,20 @@ public:
      * @param stateChangeRequester The client stateChangeRequester implementation.
      */
     void setStateChangeRequester(PvaClientChannelStateChangeRequesterPtr const &stateChangeRequester);
+    /** @brief Add a listener for connection state changes.
+     *
+     * Listeners are called in addition to the stateChangeRequester,
+     * so several clients of the same channel can follow its state.
+     * The channel keeps only a weak reference.
+     * The listener is called at once with the current state.
+     * @param listener The listener.
+     */
+    void addStateChangeListener(PvaClientChannelStateChangeRequesterPtr const &listener);
+    /** @brief Remove a listener added by addStateChangeListener.
+     *
+     * @param listener The listener.
+     */
+    void removeStateChangeListener(PvaClientChannelStateChangeRequesterPtr const &listener);
     /** @brief Get the name of the channel to which PvaClientChannel is connected.
      *
      * @return The channel name.
@@ -270,6 +1031,13 @@ public:
      * @return status.
      */
     epics::pvData::Status waitConnect(double timeout = 5.0);
+    /** @brief Issue a connect request and return a future that completes when the channel connects.
+     *
+     * The future does not time out.
+     * @return The future for the connection.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr connectAsync();
     /** @brief First call createRequest as implemented by pvDataCPP and then call the next method.
      *
      * @param request The syntax of request is defined by the copy facility of pvData.
@@ -307,6 +1075,35 @@ public:
      * @throw runtime_error if failure.
      */
     PvaClientGetPtr createGet(epics::pvData::PVStructurePtr const &  pvRequest);
+    /** @brief Issue a get using a cached PvaClientGet and return immediately.
+     *
+     * Get a cached PvaClientGet or create and connect to a new PvaClientGet.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @return The future for the get.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr getAsync(std::string const & request = "field(value,alarm,timeStamp)");
+    /** @brief create a PvaClientGetPipeline.
+     *
+     * First call createRequest as implemented by pvData and then call the next method.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @param depth The maximum number of outstanding gets.
+     * @return The interface.
+     * @throw runtime_error if failure.
+     */
+    PvaClientGetPipelinePtr createGetPipeline(
+        std::string const & request = "field(value,alarm,timeStamp)",
+        size_t depth = 4);
+    /** @brief Creates a PvaClientGetPipeline.
+     *
+     * @param pvRequest The syntax of request is defined by the copy facility of pvData.
+     * @param depth The maximum number of outstanding gets.
+     * @return The interface.
+     * @throw runtime_error if failure.
+     */
+    PvaClientGetPipelinePtr createGetPipeline(
+        epics::pvData::PVStructurePtr const &  pvRequest,
+        size_t depth = 4);
     /** @brief Get the value as a double.
      *
      * @param request The syntax of request is defined by the copy facility of pvData.
@@ -337,6 +1134,20 @@ public:
      */
     epics::pvData::shared_vector<const std::string>  getStringArray(
         std::string const & request = "field(value)");
+    /** @brief Serve getDouble, getString, getDoubleArray, and getStringArray from monitors.
+     *
+     * For each request string that is read the channel keeps a PvaClientMonitor
+     * and returns the latest monitor value instead of doing a get.
+     * A get is still done while the channel is disconnected, before the first
+     * monitor event arrives, or if no event arrived during the last maxAge seconds.
+     * @param maxAge The maximum age of a value in seconds. 0.0 means no limit.
+     */
+    void enableReadCache(double maxAge = 0.0);
+    /** @brief Stop the monitors started for enableReadCache.
+     *
+     * The convenience getters again do a get for every call.
+     */
+    void disableReadCache();
     /** @brief create a PvaClientPut.
      *
      * Get a cached PvaClientPut or create and connect to a new PvaClientPut.
@@ -374,8 +1185,10 @@ public:
      * @throw runtime_error if failure.
      */
     void putString(std::string const & value,std::string const & request = "field(value)");
-    /** @brief Copy the array to the value field.
+    /** @brief Put the array into the value field.
      *
+     * If the field is a double array the put keeps a reference to value
+     * instead of copying it. Otherwise the elements are converted.
      * @param value The new value.
      * @param request The syntax of request is defined by the copy facility of pvData.
      * @throw runtime_error if failure.
@@ -383,8 +1196,10 @@ public:
     void putDoubleArray(
         epics::pvData::shared_vector<const double> const & value,
         std::string const & request = "field(value)");
-    /** @brief Copy array to the value field.
+    /** @brief Put the array into the value field.
      *
+     * If the field is a string array the put keeps a reference to value
+     * instead of copying it. Otherwise the elements are converted.
      * @param value The new value.
      * @param request The syntax of request is defined by the copy facility of pvData.
      * @throw runtime_error if failure.
@@ -398,6 +1213,36 @@ public:
      * @throw runtime_error if failure.
      */
     void putStringArray(std::vector<std::string> const & value,std::string const & request = "field(value)");
+    /** @brief Move the array to the value field.
+     *
+     * See PvaClientPutData::moveDoubleArray.
+     * @param value The new value. It is empty when this returns.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @throw runtime_error if failure.
+     */
+    void moveDoubleArray(
+        epics::pvData::shared_vector<double> & value,
+        std::string const & request = "field(value)");
+    /** @brief Move the array to the value field.
+     *
+     * See PvaClientPutData::moveStringArray.
+     * @param value The new value. It is empty when this returns.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @throw runtime_error if failure.
+     */
+    void moveStringArray(
+        epics::pvData::shared_vector<std::string> & value,
+        std::string const & request = "field(value)");
+    /** @brief Move the array to the value field.
+     *
+     * See PvaClientPutData::moveStringArray.
+     * @param value The new value. It is empty when this returns.
+     * @param request The syntax of request is defined by the copy facility of pvData.
+     * @throw runtime_error if failure.
+     */
+    void moveStringArray(
+        std::vector<std::string> & value,
+        std::string const & request = "field(value)");
     /** @brief create a PvaClientPutGet.
      *
      * First call createRequest as implemented by pvDataJava and then calls the next method.
@@ -496,6 +1341,11 @@ public:
      /** @brief Get the number of cached gets and puts.
      */
     size_t cacheSize();
+    /** @brief Get the counters for the combined get and put caches.
+     *
+     * @return The counters.
+     */
+    PvaClientCacheStats getCacheStats();
 private:
     static PvaClientChannelPtr create(
          PvaClientPtr const &pvaClient,
@@ -508,20 +1358,33 @@ private:
 
     enum ConnectState {connectIdle,connectActive,notConnected,connected};
 
+    void sweepCache(PvaClientCacheLimits const & limits,bool reestimate);
+    void setConnectLatch(PvaClientConnectLatchPtr const & latch);
+    void releaseConnectLatch();
+    bool isChannelConnected();
+    epics::pvData::PVStructurePtr createPVRequest(
+        std::string const & request,
+        std::string const & method);
+    template<typename T>
+    T readValue(std::string const & request,T (PvaClientData::*getter)());
+
     PvaClient::weak_pointer pvaClient;
     std::string channelName;
     std::string providerName;
     ConnectState connectState;
 
-    epics::pvData::CreateRequest::shared_pointer createRequest;
     PvaClientGetCachePtr pvaClientGetCache;
     PvaClientPutCachePtr pvaClientPutCache;
+    PvaClientReadCachePtr pvaClientReadCache;
 
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
     epics::pvAccess::Channel::shared_pointer channel;
     epics::pvAccess::ChannelProvider::shared_pointer channelProvider;
     PvaClientChannelStateChangeRequesterWPtr stateChangeRequester;
+    std::vector<PvaClientChannelStateChangeRequesterWPtr> stateChangeListeners;
+    PvaClientConnectLatchPtr connectLatch;
+    PvaClientFuturePtr connectFuture;
 public:
     virtual std::string getRequesterName();
     virtual void message(std::string const & message, epics::pvData::MessageType messageType);
@@ -532,6 +1395,92 @@ public:
         epics::pvAccess::Channel::shared_pointer const & channel,
         epics::pvAccess::Channel::ConnectionState connectionState);
     friend class PvaClient;
+    friend class PvaClientChannelCache;
+    friend class PvaClientMultiChannel;
+};
+
+/**
+ * @brief The part of PvaClientFieldHandle that does not depend on the type of the field.
+ *
+ */
+class epicsShareClass PvaClientFieldPath
+{
+public:
+    /** @brief Constructor.
+     *
+     * @param path The name of the field, for example "alarm.severity".
+     * An empty path selects the single field, as used by PvaClientData::getDouble.
+     */
+    explicit PvaClientFieldPath(std::string const & path = std::string());
+    /** @brief Get the path.
+     *
+     * @return The path given to the constructor.
+     */
+    std::string getPath() const;
+    /** @brief Get the offset of the field.
+     *
+     * @return The offset in the last structure type resolved, or 0 if the field was not found.
+     */
+    size_t getOffset() const;
+    /** @brief Get the field of the single field rule.
+     *
+     * Starting at pvStructure, descend while a structure has exactly one field.
+     * The result is the first field that is not a structure,
+     * or the value field if a structure has several fields.
+     * @param pvStructure The top level structure.
+     * @return The field.
+     * @throw logic_error if the structure is empty or has several fields and no value field.
+     */
+    static epics::pvData::PVFieldPtr findSingleField(epics::pvData::PVStructurePtr const & pvStructure);
+protected:
+    /** @brief Find the offset of the field in a structure of a new type.
+     *
+     * @param pvStructure A structure of the type.
+     * @return The offset or 0 if the field does not exist.
+     */
+    size_t resolve(epics::pvData::PVStructurePtr const & pvStructure);
+
+    std::string path;
+    epics::pvData::StructureConstPtr structure;
+    size_t offset;
+};
+
+/**
+ * @brief A handle to a field that is found once and then read from each PVStructure of the same type.
+ *
+ * The path is resolved to an offset the first time a structure of a new type is seen.
+ * The field of the most recent PVStructure is kept,
+ * so reading the same instance again only compares a pointer.
+ * @tparam PVT The type of the field, for example epics::pvData::PVDouble or epics::pvData::PVField.
+ */
+template<typename PVT>
+class PvaClientFieldHandle :
+    public PvaClientFieldPath
+{
+public:
+    /** @brief Constructor.
+     *
+     * @param path The name of the field. An empty path selects the single field.
+     */
+    explicit PvaClientFieldHandle(std::string const & path = std::string())
+    : PvaClientFieldPath(path)
+    {}
+    /** @brief Get the field of a structure.
+     *
+     * @param pvStructure The structure.
+     * @return The field, or null if it does not exist or is not a PVT.
+     */
+    std::tr1::shared_ptr<PVT> get(epics::pvData::PVStructurePtr const & pvStructure)
+    {
+        if(pvStructure==this->pvStructure) return pvField;
+        if(pvStructure->getStructure()!=structure) resolve(pvStructure);
+        pvField = offset ? pvStructure->getSubField<PVT>(offset) : std::tr1::shared_ptr<PVT>();
+        this->pvStructure = pvStructure;
+        return pvField;
+    }
+private:
+    epics::pvData::PVStructurePtr pvStructure;
+    std::tr1::shared_ptr<PVT> pvField;
 };
 
 /**
@@ -640,6 +1589,34 @@ public:
      * @throw runtime_error if failure.
      */
     epics::pvData::shared_vector<const std::string>  getStringArray();
+    /** @brief Get the element type of a scalar array value.
+     *
+     * The field is found as for getDoubleArray.
+     * @return The element type.
+     * @throw logic_error if the field is not a scalar array.
+     */
+    epics::pvData::ScalarType getArrayElementType();
+    /** @brief Get the value as an array of its own element type.
+     *
+     * The field is found as for getDoubleArray.
+     * The array data is shared with the field; nothing is copied or converted.
+     * The view stays valid after the data is updated, but does not see the update.
+     * Use getArrayElementType to choose T.
+     * @return The value.
+     * @throw logic_error if the field is not a scalar array with elements of type T.
+     */
+    template<typename T>
+    epics::pvData::shared_vector<const T> getArrayView()
+    {
+        epics::pvData::PVScalarArrayPtr pvScalarArray(getSingleScalarArray("getArrayView"));
+        if(pvScalarArray->getScalarArray()->getElementType()
+        != static_cast<epics::pvData::ScalarType>(epics::pvData::ScalarTypeID<T>::value))
+        {
+            throw std::logic_error(
+                "PvaClientData::getArrayView() element type of the array is not the requested type");
+        }
+        return static_cast<epics::pvData::PVValueArray<T> *>(pvScalarArray.get())->view();
+    }
     /** @brief Get the alarm.
      * If the pvStructure has an alarm field it's values are returned.
      * Otherwise an exception is thrown.
@@ -680,6 +1657,7 @@ protected:
     static PvaClientDataPtr create(epics::pvData::StructureConstPtr const & structure);
     PvaClientData(epics::pvData::StructureConstPtr const & structure);
     epics::pvData::PVFieldPtr getSinglePVField();
+    epics::pvData::PVScalarArrayPtr getSingleScalarArray(const char * method);
     void checkValue();
     std::string messagePrefix;
 private:
@@ -697,6 +1675,8 @@ private:
     epics::pvData::BitSetPtr bitSet;
 
     epics::pvData::PVFieldPtr pvValue;
+    PvaClientFieldHandle<epics::pvData::PVField> valueField;
+    PvaClientFieldHandle<epics::pvData::PVField> singleField;
     epics::pvData::PVAlarm pvAlarm;
     epics::pvData::PVTimeStamp pvTimeStamp;
     friend class PvaClientGet;
@@ -752,12 +1732,16 @@ public:
      * If value is not a  scalar an exception is thrown.
      */
     void putString(std::string const & value);
-    /** @brief Copy the array to the value field.
-     * @param value The place where data is copied.
+    /** @brief Put the array into the value field.
+     *
+     * If the field is a double array a reference to value is kept instead of a copy.
+     * @param value The new value.
      * @throw runtime_error if failure.
      */
     void putDoubleArray(epics::pvData::shared_vector<const double> const & value);
-    /** @brief Copy array to the value field.
+    /** @brief Put the array into the value field.
+     *
+     * If the field is a string array a reference to value is kept instead of a copy.
      * @param value data source
      * @throw runtime_error if failure.
      */
@@ -767,14 +1751,42 @@ public:
      * @throw runtime_error if failure.
      */
     void putStringArray(std::vector<std::string> const & value);
+    /** @brief Move the array to the value field.
+     *
+     * If the field is a double array it takes over the data of value; nothing is copied.
+     * If value shares its data with another shared_vector the data is copied first.
+     * Otherwise the data is converted as for putDoubleArray.
+     * @param value data source. It is empty when this returns.
+     * @throw runtime_error if failure.
+     */
+    void moveDoubleArray(epics::pvData::shared_vector<double> & value);
+    /** @brief Move the array to the value field.
+     *
+     * If the field is a string array it takes over the data of value; nothing is copied.
+     * If value shares its data with another shared_vector the data is copied first.
+     * @param value data source. It is empty when this returns.
+     * @throw runtime_error if failure.
+     */
+    void moveStringArray(epics::pvData::shared_vector<std::string> & value);
+    /** @brief Move the array to the value field.
+     *
+     * The strings are swapped rather than copied.
+     * @param value data source. It is empty when this returns.
+     * @throw runtime_error if failure.
+     */
+    void moveStringArray(std::vector<std::string> & value);
     /** Factory method for creating an instance of PvaClientGetData.
      * NOTE: Not normally called by clients
      * @param structure Introspection interface
+     * @param postHandlers Install a PostHandler on every field? See PvaClient::setPutPostHandlers.
      */
-     static PvaClientPutDataPtr create(epics::pvData::StructureConstPtr const & structure);
+     static PvaClientPutDataPtr create(
+         epics::pvData::StructureConstPtr const & structure,
+         bool postHandlers = true);
 private:
-    PvaClientPutData(epics::pvData::StructureConstPtr const &structure);
+    PvaClientPutData(epics::pvData::StructureConstPtr const &structure,bool postHandlers);
     void postPut(size_t fieldNumber);
+    void setChanged(epics::pvData::PVFieldPtr const & pvField);
     std::vector<epics::pvData::PostHandlerPtr> postHandler;
     friend class PvaClientPostHandlerPvt;
     friend class PvaClientPut;
@@ -909,6 +1921,13 @@ public:
      * @return status.
      */
     epics::pvData::Status waitProcess();
+    /** @brief Issue a process and return a future for the result.
+     *
+     * Wait for the future, not with waitProcess.
+     * @return The future for the process.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr processAsync();
    /** @brief Get the PvaClientChannel;
      *
      * @return The interface.
@@ -937,7 +1956,7 @@ private:
     epics::pvData::PVStructurePtr pvRequest;
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
-    epics::pvData::Event waitForProcess;
+    epics::pvData::EventPtr waitForProcess; // only created if a thread waits
 
     epics::pvData::Status channelProcessConnectStatus;
     epics::pvData::Status channelProcessStatus;
@@ -948,6 +1967,7 @@ private:
     PvaClientProcessRequesterWPtr pvaClientProcessRequester;
     enum ProcessState {processIdle,processActive,processComplete};
     ProcessState processState;
+    PvaClientFuturePtr future;
     ChannelProcessRequesterImplPtr channelProcessRequester;
 public:
     friend class ChannelProcessRequesterImpl;
@@ -1041,6 +2061,13 @@ public:
      * @return status;
      */
     epics::pvData::Status waitGet();
+    /** @brief Issue a get and return a future for the result.
+     *
+     * Wait for the future, not with waitGet.
+     * @return The future for the get.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr getAsync();
     /**
      * @brief Get the data/
      * @return The interface.
@@ -1077,7 +2104,7 @@ private:
     epics::pvData::PVStructurePtr pvRequest;
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
-    epics::pvData::Event waitForGet;
+    epics::pvData::EventPtr waitForGet;     // only created if a thread waits
     PvaClientGetDataPtr pvaClientData;
 
     epics::pvData::Status channelGetConnectStatus;
@@ -1090,12 +2117,96 @@ private:
 
     enum GetState {getIdle,getActive,getComplete};
     GetState getState;
+    PvaClientFuturePtr future;
     ChannelGetRequesterImplPtr channelGetRequester;
 public:
     friend class ChannelGetRequesterImpl;
 };
 
 
+/**
+ * @brief A pipeline of gets where several gets can be outstanding on one channel.
+ *
+ * pvAccess allows a single outstanding get per ChannelGet,
+ * so the pipeline holds a ring of depth PvaClientGet instances on the same channel,
+ * each with its own PvaClientGetData.
+ * Gets complete in the order they were issued.
+ */
+class epicsShareClass PvaClientGetPipeline
+{
+public:
+    POINTER_DEFINITIONS(PvaClientGetPipeline);
+    /** @brief Create a PvaClientGetPipeline.
+     * @param pvaClient Interface to PvaClient
+     * @param pvaClientChannel Interface to PvaClientChannel
+     * @param pvRequest The request structure.
+     * @param depth The maximum number of outstanding gets.
+     * @return The interface to the PvaClientGetPipeline.
+     */
+    static PvaClientGetPipelinePtr create(
+        PvaClientPtr const &pvaClient,
+        PvaClientChannelPtr const & pvaClientChannel,
+        epics::pvData::PVStructurePtr const &pvRequest,
+        size_t depth
+    );
+    /** @brief Destructor
+     */
+    ~PvaClientGetPipeline();
+    /** @brief Create the channelGet connections to the channel.
+     *
+     * All connections are issued before waiting for any of them.
+     * @throw runtime_error if failure.
+     */
+    void connect();
+    /** @brief Issue a get and return immediately.
+     *
+     * @throw runtime_error if depth gets are already outstanding.
+     */
+    void issueGet();
+    /** @brief Wait until the oldest outstanding get completes.
+     *
+     * After this returns getData returns the data for that get.
+     * @return status;
+     * @throw runtime_error if no get is outstanding.
+     */
+    epics::pvData::Status waitGet();
+    /** @brief Get the data of the get most recently completed by waitGet.
+     *
+     * The data is overwritten when its slot of the ring is reused by issueGet.
+     * @return The interface.
+     * @throw runtime_error if waitGet has not been called.
+     */
+    PvaClientGetDataPtr getData();
+    /** @brief Get the maximum number of outstanding gets.
+     *
+     * @return The depth.
+     */
+    size_t getDepth();
+    /** @brief Get the number of outstanding gets.
+     *
+     * @return The number.
+     */
+    size_t getOutstanding();
+     /** @brief Get the PvaClientChannel;
+     *
+     * @return The interface.
+     */
+    PvaClientChannelPtr getPvaClientChannel();
+private:
+    PvaClientGetPipeline(
+        PvaClientChannelPtr const & pvaClientChannel,
+        std::vector<PvaClientGetPtr> const & pvaClientGets);
+
+    PvaClientChannelPtr pvaClientChannel;
+    std::vector<PvaClientGetPtr> pvaClientGets;
+    epics::pvData::Mutex mutex;
+    epics::pvData::Mutex issueMutex;
+    size_t depth;
+    size_t head;
+    size_t outstanding;
+    PvaClientGetDataPtr pvaClientData;
+};
+
 // NOTE: must use separate class that implements ChannelPutRequester,
 // because pvAccess holds a shared_ptr to ChannelPutRequester instead of weak_pointer
 class ChannelPutRequesterImpl;
@@ -1206,6 +2317,13 @@ public:
      * @return status
      */
     epics::pvData::Status waitPut();
+    /** @brief Issue a put and return a future for the result.
+     *
+     * Wait for the future, not with waitPut.
+     * @return The future for the put.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr putAsync();
     /**
      * @brief Get the data/
      * @return The interface.
@@ -1237,6 +2355,7 @@ private :
         epics::pvData::PVStructurePtr const &pvRequest);
 
     void checkConnectState();
+    void waitDone();
     enum PutConnectState {connectIdle,connectActive,connected};
 
     PvaClient::weak_pointer pvaClient;
@@ -1244,7 +2363,7 @@ private :
     epics::pvData::PVStructurePtr pvRequest;
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
-    epics::pvData::Event waitForGetPut;
+    epics::pvData::EventPtr waitForGetPut;  // only created if a thread waits
     PvaClientPutDataPtr pvaClientData;
 
     epics::pvData::Status channelPutConnectStatus;
@@ -1254,6 +2373,7 @@ private :
 
     enum PutState {putIdle,getActive,putActive,putComplete};
     PutState putState;
+    PvaClientFuturePtr future;
     ChannelPutRequesterImplPtr channelPutRequester;
     PvaClientPutRequesterWPtr pvaClientPutRequester;
 public:
@@ -1374,6 +2494,14 @@ public:
      * @return status
      */
     epics::pvData::Status waitPutGet();
+    /** @brief Issue a putGet and return a future for the result.
+     *
+     * The future holds both the put data and the get data.
+     * Wait for the future, not with waitPutGet.
+     * @return The future for the putGet.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr putGetAsync();
     /** @brief Call issueGet and then waitGetGet.
      * An exception is thrown if get fails.
      */
@@ -1441,6 +2569,7 @@ private :
         PvaClientChannelPtr const & pvaClientChannel,
         epics::pvData::PVStructurePtr const &pvRequest);
     void checkPutGetState();
+    void waitDone();
     enum PutGetConnectState {connectIdle,connectActive,connected};
 
     PvaClient::weak_pointer pvaClient;
@@ -1448,7 +2577,7 @@ private :
     epics::pvData::PVStructurePtr pvRequest;
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
-    epics::pvData::Event waitForPutGet;
+    epics::pvData::EventPtr waitForPutGet;  // only created if a thread waits
     PvaClientGetDataPtr pvaClientGetData;
     PvaClientPutDataPtr pvaClientPutData;
 
@@ -1459,6 +2588,7 @@ private :
 
     enum PutGetState {putGetIdle,putGetActive,putGetComplete};
     PutGetState putGetState;
+    PvaClientFuturePtr future;
     ChannelPutGetRequesterImplPtr channelPutGetRequester;
     PvaClientPutGetRequesterWPtr pvaClientPutGetRequester;
 public:
@@ -1500,10 +2630,73 @@ public:
 };
 
 
+/**
+ * @brief A callback for PvaClientMonitor::pollBatch.
+ *
+ */
+class epicsShareClass PvaClientMonitorVisitor
+{
+public:
+    virtual ~PvaClientMonitorVisitor() {}
+    /** @brief Called for each monitor event removed by pollBatch.
+     *
+     * The arguments are only valid during the call.
+     * @param pvStructure The data.
+     * @param changedBitSet The fields that changed.
+     * @param overrunBitSet The fields that changed more than once.
+     */
+    virtual void visit(
+        epics::pvData::PVStructurePtr const & pvStructure,
+        epics::pvData::BitSetPtr const & changedBitSet,
+        epics::pvData::BitSetPtr const & overrunBitSet) = 0;
+};
+
 // NOTE: must use separate class that implements MonitorRequester,
 // because pvAccess holds a shared_ptr to MonitorRequester instead of weak_pointer
 class MonitorRequesterImpl;
 typedef std::tr1::shared_ptr<MonitorRequesterImpl> MonitorRequesterImplPtr;
+// private to PvaClientMonitor
+class PvaClientMonitorQueue;
+typedef std::tr1::shared_ptr<PvaClientMonitorQueue> PvaClientMonitorQueuePtr;
+
+/**
+ * @brief Counters for the queue of a PvaClientMonitor.
+ *
+ */
+class epicsShareClass PvaClientMonitorQueueStats
+{
+public:
+    PvaClientMonitorQueueStats()
+    : capacity(0),
+      queued(0),
+      maxQueued(0),
+      pushed(0),
+      popped(0),
+      dropped(0),
+      squashed(0)
+    {}
+    /** Maximum number of queued updates.
+     */
+    size_t capacity;
+    /** Number of updates waiting to be polled.
+     */
+    size_t queued;
+    /** Largest number of updates that have been waiting at the same time.
+     */
+    size_t maxQueued;
+    /** Number of updates added to the queue.
+     */
+    size_t pushed;
+    /** Number of updates returned by poll.
+     */
+    size_t popped;
+    /** Number of updates discarded because the queue was full.
+     */
+    size_t dropped;
+    /** Number of updates merged into the newest queued update because the queue was full.
+     */
+    size_t squashed;
+};
 
 /**
  * @brief An easy to use alternative to Monitor.
@@ -1580,6 +2773,8 @@ public:
     */
    void start(const std::string & request);
     /** @brief Stop monitoring.
+     *
+     * A monitor registered with a PvaClientMonitorSelector is removed from it.
      */
     void stop();
     /** @brief Poll for a monitor event.
@@ -1595,9 +2790,58 @@ public:
      * @return (false,true) means event (did not, did) occur.
      */
     bool waitEvent(double secondsToWait = 0.0);
+    /** @brief Return a future that completes when a monitor event is ready to be polled.
+     *
+     * The future does not poll. When it completes with an OK status, call poll;
+     * if poll returns true the data is in PvaClientData and releaseEvent must be called.
+     * poll can return false if another thread polled first; then wait for another event.
+     * The future completes with an error status if the server stops the monitor.
+     * @return The future for the event.
+     * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr eventAsync();
     /** @brief Release the monitorElement returned by poll
      */
     void releaseEvent();
+    /** @brief Remove queued monitor events and pass each to a visitor.
+     *
+     * This replaces a poll, getData, releaseEvent sequence for each event.
+     * The events are released together after the last visit.
+     * PvaClientData is not changed.
+     * @param maxElements The maximum number of events to remove. 0 means all.
+     * @param visitor The visitor.
+     * @return The number of events visited.
+     * @throw runtime_error if failure.
+     */
+    size_t pollBatch(size_t maxElements,PvaClientMonitorVisitor & visitor);
+    /** @brief What happens to an update that arrives when the queue is full.
+     */
+    enum OverflowPolicy {
+        /** Discard the oldest queued update. */
+        dropOldest,
+        /** Discard the update that arrived. */
+        dropNewest,
+        /** Merge the update into the newest queued update. */
+        squash
+    };
+    /** @brief Move monitor events into a queue owned by the PvaClientMonitor.
+     *
+     * monitorEvent copies each update into a preallocated slot of a bounded
+     * lock free single producer single consumer ring and returns the
+     * element to pvAccess at once.
+     * poll and releaseEvent then take no lock.
+     * The overrun bit set of a squashed update shows the fields that changed more than once.
+     * This must be called before connect.
+     * @param capacity The maximum number of queued updates.
+     * @param overflowPolicy What to do when the queue is full.
+     * @throw runtime_error if already connected.
+     */
+    void setQueue(size_t capacity,OverflowPolicy overflowPolicy = dropOldest);
+    /** @brief Get the counters for the queue set by setQueue.
+     *
+     * @return The counters. All are 0 if no queue is set.
+     */
+    PvaClientMonitorQueueStats getQueueStats();
     /** @brief Get the PvaClientChannel;
      *
      * @return The interface.
@@ -1638,17 +2882,97 @@ private:
     epics::pvData::Status monitorConnectStatus;
     epics::pvData::MonitorPtr monitor;
     epics::pvData::MonitorElementPtr monitorElement;
+    std::vector<epics::pvData::MonitorElementPtr> batchElements;
 
     PvaClientMonitorRequesterWPtr pvaClientMonitorRequester;
     MonitorConnectState connectState;
     bool userPoll;
-    bool userWait;
+    int userWait;
+    int eventPending;       // set by monitorEvent, cleared by poll when empty
+    size_t queueCapacity;
+    OverflowPolicy overflowPolicy;
+    PvaClientMonitorQueuePtr queue;
+    PvaClientFuturePtr future;
     MonitorRequesterImplPtr monitorRequester;
     PvaClientChannelStateChangeRequesterWPtr pvaClientChannelStateChangeRequester; //deprecate
+    PvaClientMonitorSelectorWPtr selector;
+    bool selectorReady;     // guarded by the mutex of the selector
 public:
     void channelStateChange(PvaClientChannelPtr const & channel, bool isConnected); //deprecate
     void event(PvaClientMonitorPtr const & monitor);
     friend class MonitorRequesterImpl;
+    friend class PvaClientMonitorSelector;
+};
+
+/**
+ * @brief Wait for events from many PvaClientMonitors with one thread.
+ *
+ * monitorEvent of each registered monitor adds the monitor to a ready list,
+ * so the cost of wait depends on the number of ready monitors, not on the
+ * number of registered monitors.
+ * A monitor is reported once for each transition to ready:
+ * after wait returns it, the caller should poll it until poll returns false.
+ */
+class epicsShareClass PvaClientMonitorSelector :
+    public std::tr1::enable_shared_from_this<PvaClientMonitorSelector>
+{
+public:
+    POINTER_DEFINITIONS(PvaClientMonitorSelector);
+    /** @brief Create a PvaClientMonitorSelector.
+     *
+     * @return The interface.
+     */
+    static PvaClientMonitorSelectorPtr create();
+    /** @brief Destructor
+     */
+    ~PvaClientMonitorSelector();
+    /** @brief Register a monitor.
+     *
+     * A monitor can be registered with only one selector.
+     * It is reported as ready at once, since it may already have events.
+     * @param pvaClientMonitor The monitor.
+     */
+    void add(PvaClientMonitorPtr const & pvaClientMonitor);
+    /** @brief Unregister a monitor.
+     *
+     * A monitor is also unregistered when it is stopped or destroyed.
+     * @param pvaClientMonitor The monitor.
+     */
+    void remove(PvaClientMonitorPtr const & pvaClientMonitor);
+    /** @brief Is a monitor registered with this selector?
+     *
+     * @param pvaClientMonitor The monitor.
+     * @return (false,true) if (not, is) registered.
+     */
+    bool contains(PvaClientMonitorPtr const & pvaClientMonitor);
+    /** @brief Wait until at least one registered monitor is ready.
+     *
+     * @param ready Set to the monitors that have had an event since the previous wait.
+     * @param secondsToWait Time to wait. 0.0 means forever.
+     * @return The number of ready monitors. 0 means the wait timed out.
+     */
+    size_t wait(std::vector<PvaClientMonitorPtr> & ready,double secondsToWait = 0.0);
+    /** @brief Get the ready monitors without waiting.
+     *
+     * @param ready Set to the monitors that have had an event since the previous wait or poll.
+     * @return The number of ready monitors.
+     */
+    size_t poll(std::vector<PvaClientMonitorPtr> & ready);
+    /** @brief Get the number of registered monitors.
+     *
+     * @return The number.
+     */
+    size_t getNumberMonitors();
+private:
+    PvaClientMonitorSelector();
+    void notify(PvaClientMonitorPtr const & pvaClientMonitor);
+    void removeDestroyed();
+
+    epics::pvData::Mutex mutex;
+    epics::pvData::Event waitForReady;
+    std::vector<PvaClientMonitorPtr> readyList;
+    size_t numberMonitors;
+    friend class PvaClientMonitor;
 };
 
 
@@ -1759,6 +3083,16 @@ public:
     void request(
         epics::pvData::PVStructure::shared_pointer const & pvArgument,
         PvaClientRPCRequesterPtr const & pvaClientRPCRequester);
+    /** @brief Issue a request and return a future for the response.
+      *
+      * The response is available from the future by calling getPVStructure.
+      * A requester set by a previous request is also called.
+      * @param pvArgument The data to send to the service.
+      * @return The future for the request.
+      * @throw runtime_error if failure.
+     */
+    PvaClientFuturePtr requestAsync(
+        epics::pvData::PVStructure::shared_pointer const & pvArgument);
 private:
     PvaClientRPC(
         PvaClientPtr const &pvaClient,
@@ -1786,7 +3120,7 @@ private:
 
     epics::pvData::Mutex mutex;
     epics::pvData::Event waitForConnect;
-    epics::pvData::Event waitForDone;
+    epics::pvData::EventPtr waitForDone;    // only created if a thread waits
 
     PvaClientRPCRequesterWPtr pvaClientRPCRequester;
     RPCRequesterImplPtr rpcRequester;
@@ -1795,6 +3129,7 @@ private:
 
     enum RPCState {rpcIdle,rpcActive,rpcComplete};
     RPCState rpcState;
+    PvaClientFuturePtr future;
     epics::pvData::Status requestStatus;
     double responseTimeout;
     friend class RPCRequesterImpl;
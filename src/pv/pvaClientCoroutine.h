@@ -0,0 +1,177 @@
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+#ifndef PVACLIENTCOROUTINE_H
+#define PVACLIENTCOROUTINE_H
+
+#include <pv/pvaClient.h>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#if defined(__has_include)
+#if __has_include(<coroutine>)
+#define PVACLIENT_HAS_COROUTINE 1
+#endif
+#endif
+#endif
+
+#ifdef PVACLIENT_HAS_COROUTINE
+
+#include <atomic>
+#include <coroutine>
+
+namespace epics { namespace pvaClient {
+
+/**
+ * @brief An awaitable for a PvaClientFuture.
+ *
+ * The awaiting coroutine is resumed by the thread that completes the future,
+ * i. e. from the pvAccess callback of the request.
+ * co_await returns the future, which holds the status and the result.
+ */
+class PvaClientAwaiter
+{
+public:
+    /** @brief Constructor.
+     *
+     * @param future The future to wait for.
+     */
+    explicit PvaClientAwaiter(PvaClientFuturePtr const & future)
+    : future(future)
+    {}
+    bool await_ready() const
+    {
+        return future->isDone();
+    }
+    bool await_suspend(std::coroutine_handle<> handle)
+    {
+        std::tr1::shared_ptr<Resumer> resumer(new Resumer(handle));
+        future->then(resumer);
+        return resumer->suspend();
+    }
+    PvaClientFuturePtr await_resume() const
+    {
+        return future;
+    }
+private:
+    class Resumer : public PvaClientFutureRequester
+    {
+    public:
+        explicit Resumer(std::coroutine_handle<> handle)
+        : handle(handle),
+          state(pending)
+        {}
+        virtual void futureDone(PvaClientFuturePtr const & future)
+        {
+            int expected = pending;
+            // completed before await_suspend returned; the coroutine does not suspend
+            if(state.compare_exchange_strong(expected,completed)) return;
+            handle.resume();
+        }
+        bool suspend()
+        {
+            int expected = pending;
+            return state.compare_exchange_strong(expected,suspended);
+        }
+    private:
+        enum {pending,completed,suspended};
+        std::coroutine_handle<> handle;
+        std::atomic<int> state;
+    };
+    PvaClientFuturePtr future;
+};
+
+/** @brief Make a PvaClientFuture awaitable.
+ *
+ * @param future The future.
+ * @return The awaitable.
+ */
+inline PvaClientAwaiter operator co_await(PvaClientFuturePtr const & future)
+{
+    return PvaClientAwaiter(future);
+}
+
+/** @brief Connect a channel.
+ *
+ * @param pvaClientChannel The channel.
+ * @return The awaitable.
+ */
+inline PvaClientAwaiter asyncConnect(PvaClientChannelPtr const & pvaClientChannel)
+{
+    return PvaClientAwaiter(pvaClientChannel->connectAsync());
+}
+
+/** @brief Issue a get.
+ *
+ * @param pvaClientGet The get.
+ * @return The awaitable. The data is available from the future by calling getGetData.
+ */
+inline PvaClientAwaiter asyncGet(PvaClientGetPtr const & pvaClientGet)
+{
+    return PvaClientAwaiter(pvaClientGet->getAsync());
+}
+
+/** @brief Issue a put.
+ *
+ * @param pvaClientPut The put.
+ * @return The awaitable.
+ */
+inline PvaClientAwaiter asyncPut(PvaClientPutPtr const & pvaClientPut)
+{
+    return PvaClientAwaiter(pvaClientPut->putAsync());
+}
+
+/** @brief Issue a putGet.
+ *
+ * @param pvaClientPutGet The putGet.
+ * @return The awaitable. The get data is available from the future by calling getGetData.
+ */
+inline PvaClientAwaiter asyncPutGet(PvaClientPutGetPtr const & pvaClientPutGet)
+{
+    return PvaClientAwaiter(pvaClientPutGet->putGetAsync());
+}
+
+/** @brief Issue a process.
+ *
+ * @param pvaClientProcess The process.
+ * @return The awaitable.
+ */
+inline PvaClientAwaiter asyncProcess(PvaClientProcessPtr const & pvaClientProcess)
+{
+    return PvaClientAwaiter(pvaClientProcess->processAsync());
+}
+
+/** @brief Issue an rpc request.
+ *
+ * @param pvaClientRPC The rpc.
+ * @param pvArgument The data to send to the service.
+ * @return The awaitable. The response is available from the future by calling getPVStructure.
+ */
+inline PvaClientAwaiter asyncRequest(
+    PvaClientRPCPtr const & pvaClientRPC,
+    epics::pvData::PVStructurePtr const & pvArgument)
+{
+    return PvaClientAwaiter(pvaClientRPC->requestAsync(pvArgument));
+}
+
+/** @brief Wait for the next monitor event.
+ *
+ * When the coroutine resumes with an OK status an event is ready.
+ * The coroutine must then call poll, and releaseEvent if poll returns true.
+ * @param pvaClientMonitor The monitor.
+ * @return The awaitable.
+ */
+inline PvaClientAwaiter asyncEvent(PvaClientMonitorPtr const & pvaClientMonitor)
+{
+    return PvaClientAwaiter(pvaClientMonitor->eventAsync());
+}
+
+}}
+
+#endif  /* PVACLIENT_HAS_COROUTINE */
+
+#endif  /* PVACLIENTCOROUTINE_H */
@@ -16,6 +16,7 @@
 #   undef epicsExportSharedSymbols
 #endif
 
+#include <set>
 #include <pv/ntmultiChannel.h>
 #include <pv/createRequest.h>
 
@@ -33,12 +34,18 @@ namespace epics { namespace pvaClient {
 
 class PvaClientMultiChannel;
 typedef std::tr1::shared_ptr<PvaClientMultiChannel> PvaClientMultiChannelPtr;
+typedef std::tr1::weak_ptr<PvaClientMultiChannel> PvaClientMultiChannelWPtr;
+class PvaClientMultiChannelStateChange;
+typedef std::tr1::shared_ptr<PvaClientMultiChannelStateChange> PvaClientMultiChannelStateChangePtr;
 class PvaClientMultiGetDouble;
 typedef std::tr1::shared_ptr<PvaClientMultiGetDouble> PvaClientMultiGetDoublePtr;
 class PvaClientMultiPutDouble;
 typedef std::tr1::shared_ptr<PvaClientMultiPutDouble> PvaClientMultiPutDoublePtr;
 class PvaClientMultiMonitorDouble;
 typedef std::tr1::shared_ptr<PvaClientMultiMonitorDouble> PvaClientMultiMonitorDoublePtr;
+template<typename T> class PvaClientMultiGet;
+template<typename T> class PvaClientMultiPut;
+template<typename T> class PvaClientMultiMonitor;
 
 class PvaClientNTMultiGet;
 typedef std::tr1::shared_ptr<PvaClientNTMultiGet> PvaClientNTMultiGetPtr;
@@ -48,10 +55,14 @@ class PvaClientNTMultiMonitor;
 typedef std::tr1::shared_ptr<PvaClientNTMultiMonitor> PvaClientNTMultiMonitorPtr;
 class PvaClientNTMultiData;
 typedef std::tr1::shared_ptr<PvaClientNTMultiData> PvaClientNTMultiDataPtr;
+class PvaClientMultiFrame;
+typedef std::tr1::shared_ptr<PvaClientMultiFrame> PvaClientMultiFramePtr;
+class PvaClientMultiFrameBuilder;
+typedef std::tr1::shared_ptr<PvaClientMultiFrameBuilder> PvaClientMultiFrameBuilderPtr;
+class PvaClientMultiMonitorSet;
+typedef std::tr1::shared_ptr<PvaClientMultiMonitorSet> PvaClientMultiMonitorSetPtr;
 
 
-typedef epics::pvData::shared_vector<PvaClientChannelPtr> PvaClientChannelArray;
-
 /**
  * @brief PvaMultiChannel is a synchronous interface for accessing multiple channels.
  *
@@ -90,24 +101,44 @@ public:
     epics::pvData::shared_vector<const std::string> getChannelNames();
     /** @brief Connect to the channels.
      *
-     * This calls issueConnect and waitConnect.
-     * An exception is thrown if connect fails.
-     * @param timeout The time to wait for connecting to the channel.
+     * This calls issueConnect for every channel and then waits once
+     * until all channels are connected or timeout expires.
+     * A channel is counted as connected if it is connected when the wait ends.
+     * getConnectStatus gives the status of each channel.
+     * @param timeout The time to wait for connecting to all the channels. 0.0 means forever.
      * @return status of request
      */
     epics::pvData::Status connect(double timeout=5);
+    /** @brief Get the status of each channel when connect finished waiting.
+     *
+     * The status is not changed by later state changes; getIsConnected gives the current state.
+     * @return The status of each channel. It is empty before connect is called.
+     */
+    std::vector<epics::pvData::Status> getConnectStatus();
     /** @brief Are all channels connected?
      * @return if all are connected.
      */
     bool allConnected();
     /** @brief Has a connection state change occured?
-     * @return (true, false) if (at least one, no) channel has changed state.
+     * @return (true, false) if (at least one, no) channel has changed state
+     * since the last call to getIsConnected.
      */
     bool connectionChange();
     /** @brief Get the connection state of each channel.
+     *
+     * The state is kept up to date by the channel state change callbacks,
+     * so this does not scan the channels.
      * @return The state of each channel.
+     * The array is not modified by later state changes.
      */
     epics::pvData::shared_vector<epics::pvData::boolean> getIsConnected();
+    /** @brief Get the number of connection state changes.
+     *
+     * A caller that remembers the value can skip work that depends on
+     * getIsConnected until the value changes.
+     * @return The number of times any channel has connected or disconnected.
+     */
+    size_t getConnectionVersion();
     /** @brief Get the pvaClientChannelArray.
      * @return The shared pointer.
      */
@@ -131,6 +162,31 @@ public:
      * @return The interface.
      */
     PvaClientMultiMonitorDoublePtr createMonitor();
+    /**
+     * @brief Create a PvaClientMultiGet for value fields of type T.
+     *
+     * T is one of int32, int64, float, double, string,
+     * or shared_vector<const E> where E is one of these.
+     * @return The interface.
+     */
+    template<typename T>
+    std::tr1::shared_ptr<PvaClientMultiGet<T> > createTypedGet();
+    /**
+     * @brief Create a PvaClientMultiPut for value fields of type T.
+     *
+     * T is one of the types supported by createTypedGet.
+     * @return The interface.
+     */
+    template<typename T>
+    std::tr1::shared_ptr<PvaClientMultiPut<T> > createTypedPut();
+    /**
+     * @brief Create a PvaClientMultiMonitor for value fields of type T.
+     *
+     * T is one of the types supported by createTypedGet.
+     * @return The interface.
+     */
+    template<typename T>
+    std::tr1::shared_ptr<PvaClientMultiMonitor<T> > createTypedMonitor();
     /**
      * @brief Create a pvaClientNTMultiPut.
      * @return The interface.
@@ -150,6 +206,15 @@ public:
      */
     PvaClientNTMultiMonitorPtr createNTMonitor(
         std::string const &request= "field(value,alarm,timeStamp)");
+    /**
+     * @brief Create a pvaClientMultiFrameBuilder.
+     * @param request The request for each channel.
+     * It must select the whole timeStamp field, also when frames are grouped by userTag.
+     * @throw runtime_error if the request does not select timeStamp.
+     * @return The interface.
+     */
+    PvaClientMultiFrameBuilderPtr createFrameBuilder(
+        std::string const &request = "field(value,alarm,timeStamp)");
 private:
     PvaClientMultiChannel(
         PvaClientPtr const &pvaClient,
@@ -158,6 +223,9 @@ private:
         size_t maxNotConnected,
         epics::pvData::shared_vector<const std::string> const & providerNames);
     void checkConnected();
+    void setConnected(size_t index,bool connected);
+    void initConnected(size_t index,bool connected);
+    void changeConnected(size_t index,bool connected);
 
     PvaClientPtr pvaClient;
     epics::pvData::shared_vector<const std::string> channelNames;
@@ -172,8 +240,15 @@ private:
     size_t numConnected;
     bool firstConnect;
     PvaClientChannelArray pvaClientChannelArray;
-    epics::pvData::shared_vector<epics::pvData::boolean> isConnected;
-    epics::pvData::CreateRequest::shared_pointer createRequest;
+    std::vector<epics::pvData::boolean> isConnected;
+    std::vector<bool> isReported;       // the state change callback has run for the channel
+    std::vector<epics::pvData::Status> connectStatus;
+    epics::pvData::shared_vector<epics::pvData::boolean> isConnectedCopy;  // returned by getIsConnected
+    size_t connectionVersion;
+    size_t lastVersion;
+    size_t copyVersion;
+    std::vector<PvaClientMultiChannelStateChangePtr> stateChangeRequester;
+    friend class PvaClientMultiChannelStateChange;
 };
 
 /**
@@ -261,6 +336,85 @@ private:
     bool isPutConnected;
 };
 
+/**
+ * @brief A monitor for each connected channel of a PvaClientMultiChannel.
+ *
+ * This is used by the classes that monitor multiple channels.
+ * A PvaClientMonitorSelector reports the monitors that have events,
+ * so a poll does not visit the channels that have none.
+ * It is not thread safe; the owner calls it from one thread at a time.
+ */
+class epicsShareClass PvaClientMultiMonitorSet
+{
+public:
+    POINTER_DEFINITIONS(PvaClientMultiMonitorSet);
+    /** @brief Create a PvaClientMultiMonitorSet.
+     *
+     * No monitor is created until check is called.
+     * @param pvaClientMultiChannel The interface to PvaClientMultiChannel.
+     * @param pvaClientChannelArray The PvaClientChannel array.
+     * @param pvRequest The pvRequest for each monitor.
+     * @return The interface.
+     */
+    static PvaClientMultiMonitorSetPtr create(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray,
+         epics::pvData::PVStructurePtr const &  pvRequest);
+    /**
+     * @brief Destructor
+     */
+    ~PvaClientMultiMonitorSet();
+    /** @brief Create, connect, and start a monitor for each connected channel that has none.
+     *
+     * A monitor that was stopped is replaced.
+     * The channels are only scanned after a channel connected or disconnected,
+     * or after a monitor was stopped.
+     * @throw runtime_error if a monitor fails to connect.
+     */
+    void check();
+    /** @brief Get the channels whose monitors have had an event, without waiting.
+     *
+     * A monitor is reported again only after its next event,
+     * so the caller must take all the events of a reported monitor.
+     * @param ready Set to the index of each channel.
+     * @return The number of channels.
+     */
+    size_t poll(std::vector<size_t> & ready);
+    /** @brief Wait until a monitor has had an event.
+     *
+     * @param ready Set to the index of each channel whose monitor has had an event.
+     * @param secondsToWait The time to wait. A value that is not positive does not wait.
+     * @return The number of channels. 0 means the wait timed out.
+     */
+    size_t wait(std::vector<size_t> & ready,double secondsToWait);
+    /** @brief Get the monitor of a channel.
+     *
+     * @param index The index of the channel.
+     * @return The monitor, which is null if the channel has none.
+     */
+    PvaClientMonitorPtr getMonitor(size_t index);
+private:
+    PvaClientMultiMonitorSet(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray,
+         epics::pvData::PVStructurePtr const &  pvRequest);
+
+    bool removeStopped();
+    size_t toIndex(std::vector<size_t> & ready);
+
+    PvaClientMultiChannelPtr pvaClientMultiChannel;
+    PvaClientChannelArray pvaClientChannelArray;
+    epics::pvData::PVStructurePtr pvRequest;
+    size_t nchannel;
+    std::vector<PvaClientMonitorPtr> pvaClientMonitor;
+    bool isStarted;
+    size_t numberMonitors;
+    size_t connectionVersion;
+    PvaClientMonitorSelectorPtr selector;
+    std::map<PvaClientMonitor *,size_t> monitorIndex;
+    std::vector<PvaClientMonitorPtr> readyMonitors;
+};
+
 /**
  * @brief Provides a monitor to multiple channels where each channel has a numeric scalar value field.
  */
@@ -285,7 +439,7 @@ public:
       */
     void connect();
      /**
-     * @brief Poll each channel.
+     * @brief Poll each channel that has had a monitor event.
      *
      * If any has new data it is used to update the double[].
      * @return (false,true) if (no, at least one) value was updated.
@@ -294,7 +448,7 @@ public:
     /**
      * @brief Wait until poll returns true.
      * @param secondsToWait The time to keep trying.
-     * A thread sleep of .1 seconds occurs between each call to poll.
+     * The thread sleeps until a monitor of one of the channels has an event.
      * @return (false,true) if (timeOut, poll returned true).
      */
     bool waitEvent(double secondsToWait);
@@ -314,9 +468,168 @@ private:
     size_t nchannel;
     epics::pvData::Mutex mutex;
 
+    bool pollReady();
+
     epics::pvData::shared_vector<double> doubleValue;
-    std::vector<PvaClientMonitorPtr> pvaClientMonitor;
-    bool isMonitorConnected;
+    PvaClientMultiMonitorSetPtr monitorSet;
+    std::vector<size_t> readyChannels;
+};
+
+/**
+ * @brief Provides channelGet to multiple channels where each channel has a value field of type T.
+ *
+ * T is one of int32, int64, float, double, string, or shared_vector<const E> where E is one of these.
+ * A value field of exactly this type is copied without conversion,
+ * and an array is shared rather than copied.
+ * Other scalar types are converted.
+ */
+template<typename T>
+class epicsShareClass PvaClientMultiGet :
+    public std::tr1::enable_shared_from_this<PvaClientMultiGet<T> >
+{
+
+public:
+    POINTER_DEFINITIONS(PvaClientMultiGet);
+protected:
+    static shared_pointer create(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+    friend class PvaClientMultiChannel;
+public:
+    /**
+     * @brief Destructor
+     */
+    ~PvaClientMultiGet();
+     /**
+      * @brief Create a channelGet for each channel.
+      */
+    void connect();
+    /**
+     * @brief Get the data.
+     * @return The T[] where each element is the value field of the corresponding channel.
+     * A channel that is not connected or has no value field has the default value for T,
+     * which is NaN for float and double.
+     */
+    epics::pvData::shared_vector<T> get();
+private:
+    PvaClientMultiGet(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+
+    PvaClientMultiChannelPtr pvaClientMultiChannel;
+    PvaClientChannelArray pvaClientChannelArray;
+    size_t nchannel;
+
+    epics::pvData::shared_vector<T> value;
+    std::vector<PvaClientGetPtr> pvaClientGet;
+    bool isGetConnected;
+};
+
+/**
+ * @brief Provides channelPut to multiple channels where each channel has a value field of type T.
+ *
+ * T is one of the types supported by PvaClientMultiGet.
+ */
+template<typename T>
+class epicsShareClass PvaClientMultiPut :
+    public std::tr1::enable_shared_from_this<PvaClientMultiPut<T> >
+{
+
+public:
+    POINTER_DEFINITIONS(PvaClientMultiPut);
+protected:
+    static shared_pointer create(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+    friend class PvaClientMultiChannel;
+public:
+   /**
+     * @brief Destructor
+     */
+    ~PvaClientMultiPut();
+     /**
+     * @brief Create a channelPut for each channel.
+     */
+    void connect();
+    /** @brief Put data to each connected channel.
+     *
+     * The puts are issued to all channels before waiting for any of them.
+     * @param data The array of data for each channel.
+     */
+    void put(epics::pvData::shared_vector<T> const &data);
+
+private:
+    PvaClientMultiPut(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+
+    PvaClientMultiChannelPtr pvaClientMultiChannel;
+    PvaClientChannelArray pvaClientChannelArray;
+    size_t nchannel;
+    std::vector<PvaClientPutPtr> pvaClientPut;
+    bool isPutConnected;
+};
+
+/**
+ * @brief Provides a monitor to multiple channels where each channel has a value field of type T.
+ *
+ * T is one of the types supported by PvaClientMultiGet.
+ */
+template<typename T>
+class epicsShareClass PvaClientMultiMonitor :
+    public std::tr1::enable_shared_from_this<PvaClientMultiMonitor<T> >
+{
+
+public:
+    POINTER_DEFINITIONS(PvaClientMultiMonitor);
+protected:
+    static shared_pointer create(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+    friend class PvaClientMultiChannel;
+public:
+   /**
+     * @brief Destructor
+     */
+    ~PvaClientMultiMonitor();
+     /**
+      * @brief Connect a channel monitor for each channel.
+      */
+    void connect();
+     /**
+     * @brief Poll each channel that has had a monitor event.
+     *
+     * If any has new data it is used to update the T[].
+     * @return (false,true) if (no, at least one) value was updated.
+     */
+    bool poll();
+    /**
+     * @brief Wait until poll returns true.
+     * @param secondsToWait The time to keep trying.
+     * The thread sleeps until a monitor of one of the channels has an event.
+     * @return (false,true) if (timeOut, poll returned true).
+     */
+    bool waitEvent(double secondsToWait);
+    /**
+     * get the data.
+     *  @return The T[] where each element is the value field of the corresponding channel.
+     */
+    epics::pvData::shared_vector<T> get();
+
+private:
+    PvaClientMultiMonitor(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray);
+
+    PvaClientMultiChannelPtr pvaClientMultiChannel;
+    PvaClientChannelArray pvaClientChannelArray;
+    size_t nchannel;
+
+    bool pollReady();
+
+    epics::pvData::shared_vector<T> value;
+    PvaClientMultiMonitorSetPtr monitorSet;
+    std::vector<size_t> readyChannels;
 };
 
 /**
@@ -447,7 +760,7 @@ public:
      */
     void connect();
      /**
-     * @brief Poll each channel.
+     * @brief Poll each channel that has had a monitor event.
      *
      * @param valueOnly use only value for union.
      * If any has new data it is used to update the double[].
@@ -457,7 +770,7 @@ public:
     /**
      * @brief Wait until poll returns true.
      * @param secondsToWait The time to keep trying.
-     * A thread sleep of .1 seconds occurs between each call to poll.
+     * The thread sleeps until a monitor of one of the channels has an event.
      * @return (false,true) if (timeOut, poll returned true).
      */
     bool waitEvent(double secondsToWait);
@@ -479,9 +792,11 @@ private:
     epics::pvData::PVStructurePtr pvRequest;
     size_t nchannel;
     epics::pvData::Mutex mutex;
+    bool pollReady(bool valueOnly);
+
     PvaClientNTMultiDataPtr pvaClientNTMultiData;
-    std::vector<PvaClientMonitorPtr> pvaClientMonitor;
-    bool isConnected;
+    PvaClientMultiMonitorSetPtr monitorSet;
+    std::vector<size_t> readyChannels;
 };
 
 /**
@@ -506,6 +821,13 @@ public:
     epics::pvData::TimeStamp getTimeStamp();
     /**
      * @brief Get the  NTMultiChannel.
+     *
+     * The same NTMultiChannel is returned by every call.
+     * Only the columns that changed since the previous call are replaced.
+     * The alarm and timeStamp arrays already obtained from it are not modified.
+     * The value column is different: its elements are the PVUnion of each channel,
+     * which are shared and updated in place by each get or poll.
+     * Copy a value element to keep it.
      * @return The value.
      */
     epics::nt::NTMultiChannelPtr getNTMultiChannel();
@@ -532,6 +854,33 @@ private:
          epics::pvData::PVStructurePtr const &  pvRequest);
     void setPVStructure(
         epics::pvData::PVStructurePtr const &pvStructure,size_t index);
+    void setDisconnected(size_t index);
+    void resolveFields(size_t index,epics::pvData::PVStructurePtr const & pvStructure);
+
+    // the fields used by endDeltaTime, found once for each structure a channel delivers
+    struct ChannelFields
+    {
+        ChannelFields()
+        : valueOffset(0),severityOffset(0),statusOffset(0),messageOffset(0),
+          secondsPastEpochOffset(0),nanosecondsOffset(0),userTagOffset(0)
+        {}
+        epics::pvData::PVStructurePtr pvStructure;
+        epics::pvData::StructureConstPtr structure;
+        size_t valueOffset;
+        size_t severityOffset;
+        size_t statusOffset;
+        size_t messageOffset;
+        size_t secondsPastEpochOffset;
+        size_t nanosecondsOffset;
+        size_t userTagOffset;
+        epics::pvData::PVFieldPtr pvValue;
+        epics::pvData::PVIntPtr pvSeverity;
+        epics::pvData::PVIntPtr pvStatus;
+        epics::pvData::PVStringPtr pvMessage;
+        epics::pvData::PVLongPtr pvSecondsPastEpoch;
+        epics::pvData::PVIntPtr pvNanoseconds;
+        epics::pvData::PVIntPtr pvUserTag;
+    };
 
     PvaClientMultiChannelPtr pvaClientMultiChannel;
     PvaClientChannelArray pvaClientChannelArray;
@@ -554,8 +903,274 @@ private:
     epics::pvData::Alarm alarm;
     epics::pvData::TimeStamp timeStamp;;
     epics::pvData::PVTimeStamp pvTimeStamp;
+    epics::nt::NTMultiChannelPtr ntMultiChannel;
+    std::vector<ChannelFields> channelFields;
+    std::vector<size_t> changedIndex;
+    std::vector<size_t> lastChanged;
+    size_t connectionVersion;
+    bool alarmChanged;
+    bool timeStampChanged;
 };
 
+/**
+ * @brief The updates of a group of channels that have the same timeStamp or userTag.
+ */
+class epicsShareClass PvaClientMultiFrame
+{
+public:
+    POINTER_DEFINITIONS(PvaClientMultiFrame);
+    ~PvaClientMultiFrame();
+    /**
+     * @brief Get the number of channels.
+     * @return The number of channels.
+     */
+    size_t getNumber();
+    /**
+     * @brief Get the number of channels that have an update in this frame.
+     * @return The number.
+     */
+    size_t getNumberPresent();
+    /**
+     * @brief Get the channels that have an update in this frame.
+     * @return Array of boolean fields that are true if corresponding channel has an update.
+     */
+    epics::pvData::shared_vector<epics::pvData::boolean> getIsPresent();
+    /**
+     * @brief Get the update of a channel.
+     * @param index The index of the channel.
+     * @return The data or null if the channel has no update in this frame.
+     */
+    epics::pvData::PVStructurePtr getPVStructure(size_t index);
+    /**
+     * @brief Get the secondsPastEpoch of the frame.
+     *
+     * For a frame grouped by userTag this is taken from the first update.
+     * @return The value.
+     */
+    epics::pvData::int64 getSecondsPastEpoch();
+    /**
+     * @brief Get the nanoseconds of the frame.
+     *
+     * For a frame grouped by userTag this is taken from the first update.
+     * @return The value.
+     */
+    epics::pvData::int32 getNanoseconds();
+    /**
+     * @brief Get the userTag of the frame.
+     *
+     * For a frame grouped by timeStamp this is taken from the first update.
+     * @return The value.
+     */
+    epics::pvData::int32 getUserTag();
+private:
+    PvaClientMultiFrame(size_t nchannel);
+
+    size_t numberPresent;
+    epics::pvData::shared_vector<epics::pvData::boolean> isPresent;
+    std::vector<epics::pvData::PVStructurePtr> pvStructure;
+    epics::pvData::int64 secondsPastEpoch;
+    epics::pvData::int32 nanoseconds;
+    epics::pvData::int32 userTag;
+    epics::pvData::TimeStamp firstUpdate;
+    friend class PvaClientMultiFrameBuilder;
+};
+
+/**
+ * @brief Counters for a PvaClientMultiFrameBuilder.
+ *
+ */
+class epicsShareClass PvaClientMultiFrameStats
+{
+public:
+    PvaClientMultiFrameStats()
+    : pending(0),
+      ready(0),
+      complete(0),
+      partial(0),
+      incomplete(0),
+      dropped(0),
+      ignored(0)
+    {}
+    /** Number of frames waiting for more channels.
+     */
+    size_t pending;
+    /** Number of frames waiting to be taken by getFrame.
+     */
+    size_t ready;
+    /** Number of frames returned because every channel reported.
+     */
+    size_t complete;
+    /** Number of frames returned when they aged out with at least a quorum of channels.
+     */
+    size_t partial;
+    /** Number of frames discarded when they aged out with less than a quorum of channels.
+     */
+    size_t incomplete;
+    /** Number of ready frames discarded because getFrame was not called often enough.
+     */
+    size_t dropped;
+    /** Number of updates discarded because they had no timeStamp or belonged to a frame already returned.
+     */
+    size_t ignored;
+};
+
+/**
+ * @brief Groups the monitor updates of many channels into frames that have the same timeStamp or userTag.
+ *
+ * Every update from every channel is used, not just the latest one.
+ * A frame is ready as soon as all channels have reported.
+ * An incomplete frame ages out after maxAge seconds, or when more than maxFrames frames are incomplete,
+ * in which case the oldest ages out first.
+ * When it ages out it is ready if at least quorum channels have reported and is discarded otherwise.
+ * At most maxFrames ready frames are kept; the oldest is discarded when another becomes ready.
+ *
+ * The pvRequest must select the whole timeStamp field, also for userTagKey,
+ * since every frame reports secondsPastEpoch, nanoseconds, and userTag.
+ * An update without them is ignored.
+ */
+class epicsShareClass PvaClientMultiFrameBuilder :
+    public std::tr1::enable_shared_from_this<PvaClientMultiFrameBuilder>
+{
+
+public:
+    POINTER_DEFINITIONS(PvaClientMultiFrameBuilder);
+    /** The key used to group updates.
+     */
+    enum KeyType {
+        /** secondsPastEpoch and nanoseconds */
+        timeStampKey,
+        /** userTag */
+        userTagKey
+    };
+protected:
+    static PvaClientMultiFrameBuilderPtr create(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray,
+         epics::pvData::PVStructurePtr const &  pvRequest);
+    friend class PvaClientMultiChannel;
+public:
+   /**
+     * @brief Destructor
+     */
+    ~PvaClientMultiFrameBuilder();
+    /**
+     * @brief Set how updates are grouped.
+     *
+     * The default is timeStampKey.
+     * Either key needs the whole timeStamp field.
+     * @param keyType The key.
+     */
+    void setKeyType(KeyType keyType);
+    /**
+     * @brief Set the number of channels an incomplete frame needs when it ages out.
+     *
+     * The default is 0.
+     * @param quorum The number of channels. 0 means all channels.
+     */
+    void setQuorum(size_t quorum);
+    /**
+     * @brief Set the limits for incomplete and ready frames.
+     *
+     * The defaults are 100 frames and 1 second.
+     * @param maxFrames The maximum number of incomplete frames and of ready frames.
+     * @param maxAge The time in seconds an incomplete frame waits for more channels.
+     */
+    void setLimits(size_t maxFrames,double maxAge);
+     /**
+     * @brief Connect to a channel monitor for each channel.
+     */
+    void connect();
+    /**
+     * @brief Add the updates of each channel that has had a monitor event to their frames.
+     *
+     * Incomplete frames that are too old are also aged out.
+     * @return (false,true) if (no, at least one) frame is ready.
+     */
+    bool poll();
+    /**
+     * @brief Wait until a frame is ready.
+     * @param secondsToWait The time to keep trying.
+     * @return (false,true) if (timeOut, a frame is ready).
+     */
+    bool waitFrame(double secondsToWait);
+    /**
+     * @brief Take the oldest ready frame.
+     * @return The frame or null if no frame is ready.
+     */
+    PvaClientMultiFramePtr getFrame();
+    /**
+     * @brief Get the counters.
+     * @return The counters.
+     */
+    PvaClientMultiFrameStats getStats();
+private:
+    PvaClientMultiFrameBuilder(
+         PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+         PvaClientChannelArray const &pvaClientChannelArray,
+         epics::pvData::PVStructurePtr const &  pvRequest);
+
+    typedef std::pair<epics::pvData::int64,epics::pvData::int32> FrameKey;
+    typedef std::map<FrameKey,PvaClientMultiFramePtr> FrameMap;
+    // the monitor of a channel reuses its PVStructure, so each channel has its own handles
+    struct TimeStampFields
+    {
+        TimeStampFields()
+        : secondsPastEpoch("timeStamp.secondsPastEpoch"),
+          nanoseconds("timeStamp.nanoseconds"),
+          userTag("timeStamp.userTag")
+        {}
+        PvaClientFieldHandle<epics::pvData::PVLong> secondsPastEpoch;
+        PvaClientFieldHandle<epics::pvData::PVInt> nanoseconds;
+        PvaClientFieldHandle<epics::pvData::PVInt> userTag;
+    };
+
+    bool pollReady();
+    void addUpdate(size_t index,epics::pvData::PVStructurePtr const & pvStructure);
+    void ageOut(FrameMap::iterator iter);
+    FrameMap::iterator oldestPending();
+    void done(FrameKey const & key,PvaClientMultiFramePtr const & frame);
+
+    PvaClientMultiChannelPtr pvaClientMultiChannel;
+    PvaClientChannelArray pvaClientChannelArray;
+    epics::pvData::PVStructurePtr pvRequest;
+    size_t nchannel;
+    KeyType keyType;
+    size_t quorum;
+    size_t maxFrames;
+    double maxAge;
+
+    PvaClientMultiMonitorSetPtr monitorSet;
+    std::vector<size_t> readyChannels;
+    std::vector<TimeStampFields> timeStampFields;
+
+    FrameMap pending;
+    std::deque<PvaClientMultiFramePtr> ready;
+    std::set<FrameKey> doneKeys;
+    std::deque<FrameKey> doneOrder;
+    PvaClientMultiFrameStats stats;
+};
+
+template<typename T>
+std::tr1::shared_ptr<PvaClientMultiGet<T> > PvaClientMultiChannel::createTypedGet()
+{
+    checkConnected();
+    return PvaClientMultiGet<T>::create(shared_from_this(),pvaClientChannelArray);
+}
+
+template<typename T>
+std::tr1::shared_ptr<PvaClientMultiPut<T> > PvaClientMultiChannel::createTypedPut()
+{
+    checkConnected();
+    return PvaClientMultiPut<T>::create(shared_from_this(),pvaClientChannelArray);
+}
+
+template<typename T>
+std::tr1::shared_ptr<PvaClientMultiMonitor<T> > PvaClientMultiChannel::createTypedMonitor()
+{
+    checkConnected();
+    return PvaClientMultiMonitor<T>::create(shared_from_this(),pvaClientChannelArray);
+}
+
 
 }}
 
@@ -10,7 +10,10 @@
  */
 
 #include <map>
+#include <algorithm>
+#include <epicsAtomic.h>
 #include <pv/createRequest.h>
+#include <pv/timer.h>
 #include <pv/clientFactory.h>
 #include <pv/caProvider.h>
 
@@ -26,64 +29,481 @@ using namespace std;
 namespace epics { namespace pvaClient {
 
 
+// Number of independently locked stripes; must be a power of two.
+static const size_t channelCacheStripes = 64;
+
+class PvaClientChannelKey
+{
+public:
+    PvaClientChannelKey(
+        string const & channelName,
+        string const & providerName)
+    : hash(hashName(channelName,providerName)),
+      channelName(channelName),
+      providerName(providerName)
+    {}
+    bool operator==(PvaClientChannelKey const & other) const
+    {
+        return hash==other.hash
+            && channelName==other.channelName
+            && providerName==other.providerName;
+    }
+    size_t hash;
+    string channelName;
+    string providerName;
+private:
+    // FNV-1a over channelName, a separator, and providerName
+    static size_t hashName(string const & channelName,string const & providerName)
+    {
+        size_t value = 2166136261u;
+        for(size_t i=0; i<channelName.size(); ++i) {
+            value = (value ^ (unsigned char)channelName[i]) * 16777619u;
+        }
+        value = (value ^ 0xffu) * 16777619u;
+        for(size_t i=0; i<providerName.size(); ++i) {
+            value = (value ^ (unsigned char)providerName[i]) * 16777619u;
+        }
+        return value;
+    }
+};
+
+class PvaClientChannelCache;
+
+// sweeps the channel cache from a timer thread while limits are set
+class PvaClientChannelCacheSweeper :
+    public TimerCallback
+{
+public:
+    PvaClientChannelCacheSweeper(PvaClientChannelCache * cache)
+    : cache(cache)
+    {}
+    virtual void callback();
+    virtual void timerStopped() {}
+private:
+    PvaClientChannelCache * cache;
+};
+
 class epicsShareClass PvaClientChannelCache
 {
 public:
-    PvaClientChannelCache(){}
+    PvaClientChannelCache()
+    : limitsEnabled(0),
+      maxEntries(0),
+      sweeping(0)
+    {}
     ~PvaClientChannelCache(){
          if(PvaClient::getDebug()) cout << "PvaClientChannelCache::~PvaClientChannelCache\n";
+         // waits for a sweep in progress
+         if(timer) timer->close();
      }
     PvaClientChannelPtr getChannel(
         string const & channelName,
         string const & providerName);
-    void addChannel(PvaClientChannelPtr const & pvaClientChannel);
+    PvaClientChannelPtr addChannel(PvaClientChannelPtr const & pvaClientChannel);
+    void setLimits(PvaClientCacheLimits const & limits);
+    PvaClientCacheLimits getLimits();
+    void setRequestLimits(PvaClientCacheLimits const & limits);
+    PvaClientCacheLimits getRequestLimits();
+    void sweep();
+    void checkEntries();
     void showCache();
     size_t cacheSize();
+    PvaClientCacheStats getStats();
 private:
-    map<string,PvaClientChannelPtr> pvaClientChannelMap;
+    struct Entry
+    {
+        PvaClientChannelKey key;
+        PvaClientChannelPtr pvaClientChannel;
+        TimeStamp lastAccess;
+    };
+    struct Candidate
+    {
+        PvaClientChannelPtr pvaClientChannel;
+        TimeStamp lastAccess;
+        size_t bytes;
+    };
+    static bool lessRecent(Candidate const & left, Candidate const & right)
+    {
+        return left.lastAccess < right.lastAccess;
+    }
+    typedef std::vector<Entry> Bucket;
+    // a hash table; the low bits of the hash select the stripe, the rest the bucket
+    struct Stripe
+    {
+        Stripe()
+        : bucket(8),
+          numEntries(0),
+          hits(0),
+          misses(0),
+          evictions(0)
+        {}
+        Bucket & getBucket(PvaClientChannelKey const & key)
+        {
+            return bucket[(key.hash/channelCacheStripes) & (bucket.size()-1)];
+        }
+        Entry * find(PvaClientChannelKey const & key);
+        void grow();
+        Mutex mutex;
+        std::vector<Bucket> bucket;
+        // the counters are only changed with mutex held
+        size_t numEntries;
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+    };
+    Stripe & getStripe(PvaClientChannelKey const & key)
+    {
+        return stripe[key.hash & (channelCacheStripes-1)];
+    }
+    bool evict(Candidate const & candidate);
+    void sweepAll();
+    void updateTimer();
+    Stripe stripe[channelCacheStripes];
+    Mutex limitsMutex;
+    PvaClientCacheLimits limits;
+    PvaClientCacheLimits requestLimits;
+    TimerPtr timer;
+    TimerCallbackPtr sweeper;
+    size_t limitsEnabled;
+    size_t maxEntries;
+    size_t sweeping;
 };
 
+void PvaClientChannelCacheSweeper::callback()
+{
+    try {
+        cache->sweep();
+    } catch (std::exception& e) {
+        cerr << "PvaClientChannelCacheSweeper::callback " << e.what() << endl;
+    }
+}
+
+PvaClientChannelCache::Entry * PvaClientChannelCache::Stripe::find(PvaClientChannelKey const & key)
+{
+    Bucket & b(getBucket(key));
+    for(size_t i=0; i<b.size(); ++i) {
+        if(b[i].key==key) return &b[i];
+    }
+    return 0;
+}
+
+void PvaClientChannelCache::Stripe::grow()
+{
+    std::vector<Bucket> old(bucket.size()*2);
+    old.swap(bucket);
+    for(size_t i=0; i<old.size(); ++i) {
+        for(size_t j=0; j<old[i].size(); ++j) getBucket(old[i][j].key).push_back(old[i][j]);
+    }
+}
+
 PvaClientChannelPtr PvaClientChannelCache::getChannel(
     string const & channelName,
     string const & providerName)
 {
-    string name = channelName + providerName;
-    map<string,PvaClientChannelPtr>::iterator iter = pvaClientChannelMap.find(name);
-    if(iter!=pvaClientChannelMap.end()) return iter->second;
+    PvaClientChannelKey key(channelName,providerName);
+    Stripe & s(getStripe(key));
+    Lock xx(s.mutex);
+    Entry * entry = s.find(key);
+    if(entry) {
+        ++s.hits;
+        if(epicsAtomicGetSizeT(&limitsEnabled)) entry->lastAccess.getCurrent();
+        return entry->pvaClientChannel;
+    }
+    ++s.misses;
     return PvaClientChannelPtr();
 }
 
-void PvaClientChannelCache::addChannel(PvaClientChannelPtr const & pvaClientChannel)
+PvaClientChannelPtr PvaClientChannelCache::addChannel(PvaClientChannelPtr const & pvaClientChannel)
+{
+    PvaClientChannelKey key(pvaClientChannel->channelName,pvaClientChannel->providerName);
+    Stripe & s(getStripe(key));
+    Lock xx(s.mutex);
+    // another thread may have connected the same channel first; keep the cached one
+    Entry * found = s.find(key);
+    if(found) return found->pvaClientChannel;
+    if(s.numEntries>=s.bucket.size()) s.grow();
+    Entry entry = {key,pvaClientChannel,TimeStamp()};
+    entry.lastAccess.getCurrent();
+    s.getBucket(key).push_back(entry);
+    ++s.numEntries;
+    return pvaClientChannel;
+}
+
+static bool hasLimit(PvaClientCacheLimits const & limits)
+{
+    return limits.maxEntries>0 || limits.maxBytes>0 || limits.maxIdleTime>0.0;
+}
+
+void PvaClientChannelCache::setLimits(PvaClientCacheLimits const & limits)
+{
+    Lock xx(limitsMutex);
+    this->limits = limits;
+    epicsAtomicSetSizeT(&maxEntries,limits.maxEntries);
+    updateTimer();
+}
+
+void PvaClientChannelCache::setRequestLimits(PvaClientCacheLimits const & limits)
+{
+    Lock xx(limitsMutex);
+    requestLimits = limits;
+    updateTimer();
+}
+
+PvaClientCacheLimits PvaClientChannelCache::getRequestLimits()
+{
+    Lock xx(limitsMutex);
+    return requestLimits;
+}
+
+// caller must hold limitsMutex
+void PvaClientChannelCache::updateTimer()
 {
-     Channel::shared_pointer channel = pvaClientChannel->getChannel();
-     string name = channel->getChannelName()
-         + channel->getProvider()->getProviderName();
-    map<string,PvaClientChannelPtr>::iterator iter = pvaClientChannelMap.find(name);
-    if(iter!=pvaClientChannelMap.end()) {
-        throw std::runtime_error("pvaClientChannelCache::addChannel channel already cached");
+    bool enabled = hasLimit(limits) || hasLimit(requestLimits);
+    epicsAtomicSetSizeT(&limitsEnabled,(enabled ? 1 : 0));
+    // idle and byte limits are checked once a second
+    if(enabled && !timer) {
+        timer = TimerPtr(new Timer("pvaClientCacheSweep",lowPriority));
+        sweeper = TimerCallbackPtr(new PvaClientChannelCacheSweeper(this));
+    }
+    if(!timer) return;
+    timer->cancel(sweeper);
+    if(enabled) timer->schedulePeriodic(sweeper,1.0,1.0);
+}
+
+PvaClientCacheLimits PvaClientChannelCache::getLimits()
+{
+    Lock xx(limitsMutex);
+    return limits;
+}
+
+bool PvaClientChannelCache::evict(Candidate const & candidate)
+{
+    PvaClientChannelPtr const & pvaClientChannel(candidate.pvaClientChannel);
+    PvaClientChannelKey key(pvaClientChannel->channelName,pvaClientChannel->providerName);
+    Stripe & s(getStripe(key));
+    Lock xx(s.mutex);
+    Entry * entry = s.find(key);
+    if(!entry) return false;
+    // skip entries that were used after the candidates were collected
+    if(entry->pvaClientChannel!=pvaClientChannel) return false;
+    if(candidate.lastAccess < entry->lastAccess) return false;
+    Bucket & b(s.getBucket(key));
+    *entry = b.back();
+    b.pop_back();
+    --s.numEntries;
+    ++s.evictions;
+    return true;
+}
+
+void PvaClientChannelCache::checkEntries()
+{
+    size_t max = epicsAtomicGetSizeT(&maxEntries);
+    if(max>0 && cacheSize()>max) sweep();
+}
+
+void PvaClientChannelCache::sweep()
+{
+    if(!epicsAtomicGetSizeT(&limitsEnabled)) return;
+    // only one thread sweeps
+    if(epicsAtomicCmpAndSwapSizeT(&sweeping,0,1)!=0) return;
+    try {
+        sweepAll();
+    } catch (...) {
+        epicsAtomicSetSizeT(&sweeping,0);
+        throw;
+    }
+    epicsAtomicSetSizeT(&sweeping,0);
+}
+
+void PvaClientChannelCache::sweepAll()
+{
+    TimeStamp now;
+    now.getCurrent();
+    PvaClientCacheLimits limits(getLimits());
+    PvaClientCacheLimits requestLimits(getRequestLimits());
+    bool estimateBytes = limits.maxBytes>0 || requestLimits.maxBytes>0;
+    if(PvaClient::getDebug()) cout << "PvaClientChannelCache::sweep\n";
+    std::vector<Candidate> candidates;
+    for(size_t i=0; i<channelCacheStripes; ++i)
+    {
+        Lock xx(stripe[i].mutex);
+        for(size_t j=0; j<stripe[i].bucket.size(); ++j)
+        {
+            Bucket const & b(stripe[i].bucket[j]);
+            for(size_t k=0; k<b.size(); ++k) {
+                Candidate candidate;
+                candidate.pvaClientChannel = b[k].pvaClientChannel;
+                candidate.lastAccess = b[k].lastAccess;
+                candidate.bytes = 0;
+                candidates.push_back(candidate);
+            }
+        }
+    }
+    size_t totalBytes = 0;
+    for(size_t i=0; i<candidates.size(); ++i)
+    {
+        candidates[i].pvaClientChannel->sweepCache(requestLimits,estimateBytes);
+        candidates[i].bytes = candidates[i].pvaClientChannel->getCacheStats().bytes;
+        totalBytes += candidates[i].bytes;
+    }
+    std::sort(candidates.begin(),candidates.end(),lessRecent);
+    size_t entries = candidates.size();
+    for(size_t i=0; i<candidates.size(); ++i)
+    {
+        Candidate const & candidate(candidates[i]);
+        bool isIdle = limits.maxIdleTime>0.0
+            && TimeStamp::diff(now,candidate.lastAccess)>limits.maxIdleTime;
+        bool tooMany = limits.maxEntries>0 && entries>limits.maxEntries;
+        bool tooBig = limits.maxBytes>0 && totalBytes>limits.maxBytes;
+        if(!isIdle && !tooMany && !tooBig) break;
+        if(!evict(candidate)) continue;
+        entries--;
+        totalBytes -= candidate.bytes;
     }
-    pvaClientChannelMap.insert(std::pair<string,PvaClientChannelPtr>(
-         name,pvaClientChannel));
 }
 
 void PvaClientChannelCache::showCache()
 {
-    map<string,PvaClientChannelPtr>::iterator iter;
-    for(iter = pvaClientChannelMap.begin(); iter != pvaClientChannelMap.end(); ++iter)
+    for(size_t i=0; i<channelCacheStripes; ++i)
     {
-         PvaClientChannelPtr pvaChannel = iter->second;
-         Channel::shared_pointer channel = pvaChannel->getChannel();
-         string channelName = channel->getChannelName();
-         string providerName = channel->getProvider()->getProviderName();
-         cout << "channel " << channelName << " provider " << providerName << endl;
-         pvaChannel->showCache();
+        std::vector<PvaClientChannelPtr> channels;
+        {
+            Lock xx(stripe[i].mutex);
+            for(size_t j=0; j<stripe[i].bucket.size(); ++j)
+            {
+                Bucket const & b(stripe[i].bucket[j]);
+                for(size_t k=0; k<b.size(); ++k) channels.push_back(b[k].pvaClientChannel);
+            }
+        }
+        for(size_t j=0; j<channels.size(); ++j)
+        {
+            PvaClientChannelPtr pvaChannel = channels[j];
+            cout << "channel " << pvaChannel->getChannelName()
+                 << " provider " << pvaChannel->providerName << endl;
+            pvaChannel->showCache();
+        }
     }
 }
 
 size_t PvaClientChannelCache::cacheSize()
 {
-    return pvaClientChannelMap.size();
+    size_t entries = 0;
+    for(size_t i=0; i<channelCacheStripes; ++i)
+    {
+        Lock xx(stripe[i].mutex);
+        entries += stripe[i].numEntries;
+    }
+    return entries;
+}
+
+PvaClientCacheStats PvaClientChannelCache::getStats()
+{
+    PvaClientCacheStats stats;
+    for(size_t i=0; i<channelCacheStripes; ++i)
+    {
+        std::vector<PvaClientChannelPtr> channels;
+        {
+            Lock xx(stripe[i].mutex);
+            for(size_t j=0; j<stripe[i].bucket.size(); ++j)
+            {
+                Bucket const & b(stripe[i].bucket[j]);
+                for(size_t k=0; k<b.size(); ++k) channels.push_back(b[k].pvaClientChannel);
+            }
+            stats.hits += stripe[i].hits;
+            stats.misses += stripe[i].misses;
+            stats.evictions += stripe[i].evictions;
+        }
+        stats.entries += channels.size();
+        for(size_t j=0; j<channels.size(); ++j)
+        {
+            stats.bytes += channels[j]->getCacheStats().bytes;
+        }
+    }
+    return stats;
+}
+
+class epicsShareClass PvaClientPVRequestCache
+{
+public:
+    PvaClientPVRequestCache()
+    : createRequest(CreateRequest::create())
+    {}
+    ~PvaClientPVRequestCache(){
+         if(PvaClient::getDebug()) cout << "PvaClientPVRequestCache::~PvaClientPVRequestCache\n";
+     }
+    PVStructurePtr getPVRequest(string const & request);
+private:
+    Mutex mutex;
+    CreateRequest::shared_pointer createRequest;
+    map<string,PVStructurePtr> pvRequestMap;
+};
+
+PVStructurePtr PvaClientPVRequestCache::getPVRequest(string const & request)
+{
+    Lock xx(mutex);
+    map<string,PVStructurePtr>::iterator iter = pvRequestMap.find(request);
+    if(iter!=pvRequestMap.end()) return iter->second;
+    PVStructurePtr pvRequest = createRequest->createRequest(request);
+    if(!pvRequest) {
+        throw std::runtime_error("invalid pvRequest: " + createRequest->getMessage());
+    }
+    pvRequest->setImmutable();
+    pvRequestMap.insert(std::pair<string,PVStructurePtr>(request,pvRequest));
+    return pvRequest;
+}
 
+PvaClientConnectLatchPtr PvaClientConnectLatch::create(size_t count)
+{
+    PvaClientConnectLatchPtr latch(new PvaClientConnectLatch(count));
+    return latch;
+}
+
+PvaClientConnectLatch::PvaClientConnectLatch(size_t count)
+: count(count)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientConnectLatch::PvaClientConnectLatch count " << count << endl;
+}
+
+PvaClientConnectLatch::~PvaClientConnectLatch()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientConnectLatch::~PvaClientConnectLatch\n";
+}
+
+void PvaClientConnectLatch::countDown()
+{
+    Lock xx(mutex);
+    if(count==0) return;
+    --count;
+    if(count==0) event.signal();
+}
+
+size_t PvaClientConnectLatch::getCount()
+{
+    Lock xx(mutex);
+    return count;
+}
+
+bool PvaClientConnectLatch::wait(double timeout)
+{
+    TimeStamp start;
+    start.getCurrent();
+    while(true) {
+        {
+            Lock xx(mutex);
+            if(count==0) return true;
+        }
+        if(timeout>0.0) {
+            TimeStamp now;
+            now.getCurrent();
+            double remaining = timeout - TimeStamp::diff(now,start);
+            if(remaining<=0.0) break;
+            event.wait(remaining);
+        } else {
+            event.wait();
+        }
+    }
+    Lock xx(mutex);
+    return count==0;
 }
 
 // MSVC doesn't like making this a class static data member:
@@ -114,6 +534,8 @@ PvaClientPtr PvaClient::create() {return get();}
 
 PvaClient::PvaClient(std::string const & providerNames)
 :  pvaClientChannelCache(new PvaClientChannelCache()),
+   pvaClientPVRequestCache(new PvaClientPVRequestCache()),
+   putPostHandlers(true),
    pvaStarted(false),
    caStarted(false),
    channelRegistry(ChannelProviderRegistry::clients())
@@ -196,10 +618,61 @@ PvaClientChannelPtr PvaClient::channel(
     if(pvaClientChannel) return pvaClientChannel;
     pvaClientChannel = createChannel(channelName,providerName);
     pvaClientChannel->connect(timeOut);
-    pvaClientChannelCache->addChannel(pvaClientChannel);
+    pvaClientChannel = pvaClientChannelCache->addChannel(pvaClientChannel);
+    pvaClientChannelCache->checkEntries();
     return pvaClientChannel;
 }
 
+std::vector<Status> PvaClient::channels(
+        shared_vector<const string> const & channelNames,
+        PvaClientChannelArray & pvaClientChannels,
+        string const & providerName,
+        double timeOut)
+{
+    if(getDebug()) cout << "PvaClient::channels number " << channelNames.size() << endl;
+    size_t numChannel = channelNames.size();
+    std::vector<Status> status(numChannel,Status::Ok);
+    std::vector<bool> isNew(numChannel,false);
+    PvaClientChannelArray pvaChannels(numChannel);
+    PvaClientConnectLatchPtr latch(PvaClientConnectLatch::create(numChannel));
+    for(size_t i=0; i<numChannel; ++i) {
+        pvaChannels[i] = pvaClientChannelCache->getChannel(channelNames[i],providerName);
+        if(pvaChannels[i]) {
+            latch->countDown();
+            continue;
+        }
+        pvaChannels[i] = createChannel(channelNames[i],providerName);
+        isNew[i] = true;
+        pvaChannels[i]->setConnectLatch(latch);
+        try {
+            pvaChannels[i]->issueConnect();
+        } catch (std::exception& e) {
+            status[i] = Status(Status::STATUSTYPE_ERROR,e.what());
+            pvaChannels[i]->releaseConnectLatch();
+        }
+    }
+    latch->wait(timeOut);
+    for(size_t i=0; i<numChannel; ++i) {
+        if(!isNew[i]) continue;
+        pvaChannels[i]->releaseConnectLatch();
+        if(!status[i].isOK()) continue;
+        if(pvaChannels[i]->isChannelConnected()) {
+            pvaChannels[i] = pvaClientChannelCache->addChannel(pvaChannels[i]);
+        } else {
+            status[i] = Status(Status::STATUSTYPE_ERROR,
+                string("channel ") + channelNames[i] + " PvaClient::channels not connected");
+        }
+    }
+    pvaClientChannelCache->checkEntries();
+    pvaClientChannels = pvaChannels;
+    return status;
+}
+
+PVStructurePtr PvaClient::createRequest(string const & request)
+{
+    return pvaClientPVRequestCache->getPVRequest(request);
+}
+
 PvaClientChannelPtr PvaClient::createChannel(string const & channelName, string const & providerName)
 {
      return PvaClientChannel::create(shared_from_this(),channelName,providerName);
@@ -230,4 +703,59 @@ size_t PvaClient::cacheSize()
     return pvaClientChannelCache->cacheSize();
 }
 
+void PvaClient::setCacheLimits(PvaClientCacheLimits const & limits)
+{
+    if(getDebug()) cout << "PvaClient::setCacheLimits\n";
+    pvaClientChannelCache->setLimits(limits);
+    pvaClientChannelCache->sweep();
+}
+
+PvaClientCacheLimits PvaClient::getCacheLimits()
+{
+    return pvaClientChannelCache->getLimits();
+}
+
+void PvaClient::setRequestCacheLimits(PvaClientCacheLimits const & limits)
+{
+    if(getDebug()) cout << "PvaClient::setRequestCacheLimits\n";
+    pvaClientChannelCache->setRequestLimits(limits);
+    pvaClientChannelCache->sweep();
+}
+
+PvaClientCacheLimits PvaClient::getRequestCacheLimits()
+{
+    return pvaClientChannelCache->getRequestLimits();
+}
+
+PvaClientCacheStats PvaClient::getCacheStats()
+{
+    return pvaClientChannelCache->getStats();
+}
+
+void PvaClient::setExecutor(PvaClientExecutorPtr const & executor)
+{
+    if(getDebug()) cout << "PvaClient::setExecutor\n";
+    Lock xx(mutex);
+    this->executor = executor;
+}
+
+PvaClientExecutorPtr PvaClient::getExecutor()
+{
+    Lock xx(mutex);
+    return executor;
+}
+
+void PvaClient::setPutPostHandlers(bool value)
+{
+    if(getDebug()) cout << "PvaClient::setPutPostHandlers\n";
+    Lock xx(mutex);
+    putPostHandlers = value;
+}
+
+bool PvaClient::getPutPostHandlers()
+{
+    Lock xx(mutex);
+    return putPostHandlers;
+}
+
 }}
@@ -10,6 +10,7 @@
  */
 
 #include <map>
+#include <list>
 #include <pv/event.h>
 #include <pv/lock.h>
 #include <pv/createRequest.h>
@@ -25,54 +26,219 @@ using namespace std;
 namespace epics { namespace pvaClient {
 
 
-class epicsShareClass PvaClientGetCache
+// estimate the number of data bytes held by a pvField
+static size_t pvFieldBytes(PVFieldPtr const & pvField)
 {
-public:
-    PvaClientGetCache(){}
-    ~PvaClientGetCache()
+    if(!pvField) return 0;
+    switch(pvField->getField()->getType()) {
+    case scalar:
     {
-        if(PvaClient::getDebug()) cout << "PvaClientGetCache::~PvaClientGetCache\n";
+        PVScalarPtr pvScalar = std::tr1::static_pointer_cast<PVScalar>(pvField);
+        ScalarType scalarType = pvScalar->getScalar()->getScalarType();
+        if(scalarType==pvString) return pvScalar->getAs<string>().size();
+        return ScalarTypeFunc::elementSize(scalarType);
     }
-    PvaClientGetPtr getGet(string const & request);
-    void addGet(string const & request,PvaClientGetPtr const & pvaClientGet);
+    case scalarArray:
+    {
+        PVScalarArrayPtr pvArray = std::tr1::static_pointer_cast<PVScalarArray>(pvField);
+        ScalarType scalarType = pvArray->getScalarArray()->getElementType();
+        if(scalarType!=pvString) {
+            return pvArray->getLength()*ScalarTypeFunc::elementSize(scalarType);
+        }
+        PVStringArray::const_svector data(
+            std::tr1::static_pointer_cast<PVStringArray>(pvField)->view());
+        size_t bytes = 0;
+        for(size_t i=0; i<data.size(); ++i) bytes += data[i].size();
+        return bytes;
+    }
+    case structure:
+    {
+        PVFieldPtrArray const & pvFields
+            = std::tr1::static_pointer_cast<PVStructure>(pvField)->getPVFields();
+        size_t bytes = 0;
+        for(size_t i=0; i<pvFields.size(); ++i) bytes += pvFieldBytes(pvFields[i]);
+        return bytes;
+    }
+    case structureArray:
+    {
+        PVStructureArray::const_svector data(
+            std::tr1::static_pointer_cast<PVStructureArray>(pvField)->view());
+        size_t bytes = 0;
+        for(size_t i=0; i<data.size(); ++i) bytes += pvFieldBytes(data[i]);
+        return bytes;
+    }
+    case union_:
+        return pvFieldBytes(std::tr1::static_pointer_cast<PVUnion>(pvField)->get());
+    case unionArray:
+    {
+        PVUnionArray::const_svector data(
+            std::tr1::static_pointer_cast<PVUnionArray>(pvField)->view());
+        size_t bytes = 0;
+        for(size_t i=0; i<data.size(); ++i) bytes += pvFieldBytes(data[i]);
+        return bytes;
+    }
+    }
+    return 0;
+}
+
+// sizes are needed for the byte budget of the request caches or of the channel cache
+static bool needBytes(PvaClientPtr const & pvaClient,PvaClientCacheLimits const & requestLimits)
+{
+    return requestLimits.maxBytes>0 || pvaClient->getCacheLimits().maxBytes>0;
+}
+
+template<typename Ptr>
+class PvaClientRequestCache
+{
+public:
+    PvaClientRequestCache()
+    : bytes(0),
+      generation(0),
+      hits(0),
+      misses(0),
+      evictions(0)
+    {}
+    Ptr getRequest(string const & request,bool * estimate = 0);
+    Ptr addRequest(string const & request,Ptr const & value);
+    void setBytes(string const & request,size_t bytes);
+    void sweep(PvaClientCacheLimits const & limits,bool reestimate);
     void showCache();
     size_t cacheSize();
+    void addStats(PvaClientCacheStats & stats);
 private:
-    map<string,PvaClientGetPtr> pvaClientGetMap;
+    typedef std::list<string> LruList;
+    struct Entry
+    {
+        Ptr value;
+        TimeStamp lastAccess;
+        size_t bytes;
+        size_t generation;      // value of generation when bytes was estimated
+        typename LruList::iterator position;
+    };
+    typedef map<string,Entry> RequestMap;
+    RequestMap requestMap;
+    // least recently used first
+    LruList lruList;
+    Mutex mutex;
+    size_t bytes;
+    size_t generation;          // incremented by each sweep that needs byte estimates
+    size_t hits;
+    size_t misses;
+    size_t evictions;
 };
 
-PvaClientGetPtr PvaClientGetCache::getGet(string const & request)
+// if estimate is given it is set when the size of the entry should be estimated again
+template<typename Ptr>
+Ptr PvaClientRequestCache<Ptr>::getRequest(string const & request,bool * estimate)
 {
-    map<string,PvaClientGetPtr>::iterator iter = pvaClientGetMap.find(request);
-    if(iter!=pvaClientGetMap.end()) return iter->second;
-    return PvaClientGetPtr();
+    Lock xx(mutex);
+    typename RequestMap::iterator iter = requestMap.find(request);
+    if(iter==requestMap.end()) {
+        ++misses;
+        return Ptr();
+    }
+    ++hits;
+    iter->second.lastAccess.getCurrent();
+    lruList.splice(lruList.end(),lruList,iter->second.position);
+    if(estimate) {
+        *estimate = (iter->second.generation!=generation);
+        iter->second.generation = generation;
+    }
+    return iter->second.value;
 }
 
-void PvaClientGetCache::addGet(string const & request,PvaClientGetPtr const & pvaClientGet)
+template<typename Ptr>
+Ptr PvaClientRequestCache<Ptr>::addRequest(string const & request,Ptr const & value)
 {
-     map<string,PvaClientGetPtr>::iterator iter = pvaClientGetMap.find(request);
-     if(iter!=pvaClientGetMap.end()) {
-         throw std::runtime_error("pvaClientGetCache::addGet pvaClientGet already cached");
-     }
-     pvaClientGetMap.insert(std::pair<string,PvaClientGetPtr>(request,pvaClientGet));
+    Lock xx(mutex);
+    Entry entry;
+    entry.value = value;
+    entry.lastAccess.getCurrent();
+    entry.bytes = 0;
+    entry.generation = generation;
+    // another thread may have created the same request first; keep the cached one
+    std::pair<typename RequestMap::iterator,bool> result =
+        requestMap.insert(typename RequestMap::value_type(request,entry));
+    if(result.second) result.first->second.position = lruList.insert(lruList.end(),request);
+    return result.first->second.value;
 }
 
-void PvaClientGetCache::showCache()
+template<typename Ptr>
+void PvaClientRequestCache<Ptr>::setBytes(string const & request,size_t bytes)
 {
-    map<string,PvaClientGetPtr>::iterator iter;
-    for(iter = pvaClientGetMap.begin(); iter != pvaClientGetMap.end(); ++iter)
+    Lock xx(mutex);
+    typename RequestMap::iterator iter = requestMap.find(request);
+    if(iter==requestMap.end()) return;
+    this->bytes -= iter->second.bytes;
+    this->bytes += bytes;
+    iter->second.bytes = bytes;
+}
+
+template<typename Ptr>
+void PvaClientRequestCache<Ptr>::sweep(PvaClientCacheLimits const & limits,bool reestimate)
+{
+    Lock xx(mutex);
+    // arrays change size, so an entry used after this sweep is estimated again
+    if(reestimate) ++generation;
+    if(limits.maxEntries==0 && limits.maxBytes==0 && limits.maxIdleTime<=0.0) return;
+    TimeStamp now;
+    now.getCurrent();
+    while(!lruList.empty()) {
+        typename RequestMap::iterator oldest = requestMap.find(lruList.front());
+        bool isIdle = limits.maxIdleTime>0.0
+            && TimeStamp::diff(now,oldest->second.lastAccess)>limits.maxIdleTime;
+        bool tooMany = limits.maxEntries>0 && requestMap.size()>limits.maxEntries;
+        bool tooBig = limits.maxBytes>0 && bytes>limits.maxBytes;
+        if(!isIdle && !tooMany && !tooBig) break;
+        bytes -= oldest->second.bytes;
+        requestMap.erase(oldest);
+        lruList.pop_front();
+        ++evictions;
+    }
+}
+
+template<typename Ptr>
+void PvaClientRequestCache<Ptr>::showCache()
+{
+    Lock xx(mutex);
+    typename RequestMap::iterator iter;
+    for(iter = requestMap.begin(); iter != requestMap.end(); ++iter)
     {
          cout << "        " << iter->first << endl;
     }
 }
 
-size_t PvaClientGetCache::cacheSize()
+template<typename Ptr>
+size_t PvaClientRequestCache<Ptr>::cacheSize()
 {
-    return pvaClientGetMap.size();
+    Lock xx(mutex);
+    return requestMap.size();
+}
 
+template<typename Ptr>
+void PvaClientRequestCache<Ptr>::addStats(PvaClientCacheStats & stats)
+{
+    Lock xx(mutex);
+    stats.entries += requestMap.size();
+    stats.bytes += bytes;
+    stats.hits += hits;
+    stats.misses += misses;
+    stats.evictions += evictions;
 }
 
-class epicsShareClass PvaClientPutCache
+class epicsShareClass PvaClientGetCache :
+    public PvaClientRequestCache<PvaClientGetPtr>
+{
+public:
+    PvaClientGetCache(){}
+    ~PvaClientGetCache()
+    {
+        if(PvaClient::getDebug()) cout << "PvaClientGetCache::~PvaClientGetCache\n";
+    }
+};
+
+class epicsShareClass PvaClientPutCache :
+    public PvaClientRequestCache<PvaClientPutPtr>
 {
 public:
     PvaClientPutCache(){}
@@ -80,46 +246,140 @@ public:
     {
          if(PvaClient::getDebug()) cout << "PvaClientPutCache::~PvaClientPutCache\n";
     }
-    PvaClientPutPtr getPut(string const & request);
-    void addPut(string const & request,PvaClientPutPtr const & pvaClientPut);
-    void showCache();
-    size_t cacheSize();
-private:
-    map<string,PvaClientPutPtr> pvaClientPutMap;
 };
 
-
-PvaClientPutPtr PvaClientPutCache::getPut(string const & request)
-{
-    map<string,PvaClientPutPtr>::iterator iter = pvaClientPutMap.find(request);
-    if(iter!=pvaClientPutMap.end()) return iter->second;
-    return PvaClientPutPtr();
-}
-
-void PvaClientPutCache::addPut(string const & request,PvaClientPutPtr const & pvaClientPut)
-{
-     map<string,PvaClientPutPtr>::iterator iter = pvaClientPutMap.find(request);
-     if(iter!=pvaClientPutMap.end()) {
-         throw std::runtime_error("pvaClientPutCache::addPut pvaClientPut already cached");
-     }
-     pvaClientPutMap.insert(std::pair<string,PvaClientPutPtr>(
-         request,pvaClientPut));
-}
-
-void PvaClientPutCache::showCache()
+// keeps the latest value of a monitor for the convenience getters
+class PvaClientReadCacheEntry :
+    public PvaClientMonitorRequester
 {
-    map<string,PvaClientPutPtr>::iterator iter;
-    for(iter = pvaClientPutMap.begin(); iter != pvaClientPutMap.end(); ++iter)
+public:
+    POINTER_DEFINITIONS(PvaClientReadCacheEntry);
+    PvaClientReadCacheEntry()
+    : hasData(false)
+    {}
+    ~PvaClientReadCacheEntry()
     {
-         cout << "        " << iter->first << endl;
+        if(PvaClient::getDebug()) cout << "PvaClientReadCacheEntry::~PvaClientReadCacheEntry\n";
     }
-}
+    virtual void event(PvaClientMonitorPtr const & monitor)
+    {
+        Lock xx(mutex);
+        while(monitor->poll()) {
+            PvaClientMonitorDataPtr monitorData(monitor->getData());
+            PVStructurePtr pvFrom(monitorData->getPVStructure());
+            if(!pvStructure) {
+                pvStructure = getPVDataCreate()->createPVStructure(pvFrom->getStructure());
+                bitSet = BitSetPtr(new BitSet(pvStructure->getNumberFields()));
+                data = PvaClientGetData::create(pvStructure->getStructure());
+                data->setData(pvStructure,bitSet);
+            }
+            pvStructure->copyUnchecked(*pvFrom);
+            *bitSet = *monitorData->getChangedBitSet();
+            monitor->releaseEvent();
+            hasData = true;
+            lastUpdate.getCurrent();
+        }
+    }
+    virtual void unlisten()
+    {
+        invalidate();
+    }
+    void invalidate()
+    {
+        Lock xx(mutex);
+        hasData = false;
+    }
+    void touch()
+    {
+        Lock xx(mutex);
+        lastUpdate.getCurrent();
+    }
+    template<typename T>
+    bool read(T (PvaClientData::*getter)(),double maxAge,T & value)
+    {
+        Lock xx(mutex);
+        if(!hasData) return false;
+        if(maxAge>0.0) {
+            TimeStamp now;
+            now.getCurrent();
+            if(TimeStamp::diff(now,lastUpdate)>maxAge) return false;
+        }
+        value = ((*data).*getter)();
+        return true;
+    }
+    PvaClientMonitorPtr pvaClientMonitor;
+private:
+    Mutex mutex;
+    PVStructurePtr pvStructure;
+    BitSetPtr bitSet;
+    PvaClientGetDataPtr data;
+    TimeStamp lastUpdate;
+    bool hasData;
+};
+typedef std::tr1::shared_ptr<PvaClientReadCacheEntry> PvaClientReadCacheEntryPtr;
 
-size_t PvaClientPutCache::cacheSize()
+class epicsShareClass PvaClientReadCache
 {
-    return pvaClientPutMap.size();
-
-}
+public:
+    PvaClientReadCache(double maxAge)
+    : maxAge(maxAge)
+    {}
+    ~PvaClientReadCache()
+    {
+        if(PvaClient::getDebug()) cout << "PvaClientReadCache::~PvaClientReadCache\n";
+        EntryMap::iterator iter;
+        for(iter = entryMap.begin(); iter != entryMap.end(); ++iter) {
+            iter->second->pvaClientMonitor->stop();
+        }
+    }
+    PvaClientReadCacheEntryPtr getEntry(
+        string const & request,
+        PvaClientChannelPtr const & pvaClientChannel)
+    {
+        {
+            Lock xx(mutex);
+            EntryMap::iterator iter = entryMap.find(request);
+            if(iter!=entryMap.end()) return iter->second;
+        }
+        // createMonitor may wait for the channel, so do not hold the lock
+        PvaClientReadCacheEntryPtr entry(new PvaClientReadCacheEntry());
+        entry->pvaClientMonitor = pvaClientChannel->createMonitor(request);
+        entry->pvaClientMonitor->setRequester(entry);
+        // monitorConnect starts the monitor; until the first event reads do a get
+        entry->pvaClientMonitor->issueConnect();
+        PvaClientReadCacheEntryPtr other;
+        {
+            Lock xx(mutex);
+            EntryMap::iterator iter = entryMap.find(request);
+            if(iter==entryMap.end()) {
+                entryMap.insert(EntryMap::value_type(request,entry));
+                return entry;
+            }
+            other = iter->second;
+        }
+        // another thread created the same entry first; ours is destroyed with its monitor
+        return other;
+    }
+    void invalidate()
+    {
+        vector<PvaClientReadCacheEntryPtr> entries;
+        {
+            Lock xx(mutex);
+            entries.reserve(entryMap.size());
+            EntryMap::iterator iter;
+            for(iter = entryMap.begin(); iter != entryMap.end(); ++iter) {
+                entries.push_back(iter->second);
+            }
+        }
+        for(size_t i=0; i<entries.size(); ++i) entries[i]->invalidate();
+    }
+    double getMaxAge() { return maxAge; }
+private:
+    typedef map<string,PvaClientReadCacheEntryPtr> EntryMap;
+    EntryMap entryMap;
+    Mutex mutex;
+    double maxAge;
+};
 
 PvaClientChannelPtr PvaClientChannel::create(
    PvaClientPtr const &pvaClient,
@@ -139,7 +399,6 @@ PvaClientChannel::PvaClientChannel(
   channelName(channelName),
   providerName(providerName),
   connectState(connectIdle),
-  createRequest(CreateRequest::create()),
   pvaClientGetCache(new PvaClientGetCache()),
   pvaClientPutCache(new PvaClientPutCache())
 {
@@ -198,8 +457,14 @@ void PvaClientChannel::channelStateChange(
     bool waitingForConnect = false;
     if(connectState==connectActive) waitingForConnect = true;
     if(connectionState!=Channel::CONNECTED) {
-        Lock xx(mutex);
-        connectState = notConnected;
+        PvaClientReadCachePtr readCache;
+        {
+            Lock xx(mutex);
+            connectState = notConnected;
+            readCache = pvaClientReadCache;
+        }
+        // entry locks are never taken while the channel lock is held
+        if(readCache) readCache->invalidate();
     } else {
         Lock xx(mutex);
         this->channel = channel;
@@ -209,10 +474,37 @@ void PvaClientChannel::channelStateChange(
          Lock xx(mutex);
          waitForConnect.signal();
     }
+    if(connectionState==Channel::CONNECTED) {
+        releaseConnectLatch();
+        PvaClientFuturePtr future;
+        {
+            Lock xx(mutex);
+            future.swap(connectFuture);
+        }
+        if(future) future->complete(Status::Ok);
+    }
+    bool value = (connectionState==Channel::CONNECTED ? true :  false);
     PvaClientChannelStateChangeRequesterPtr req(stateChangeRequester.lock());
     if(req) {
-         bool value = (connectionState==Channel::CONNECTED ? true :  false);
-         req->channelStateChange(shared_from_this(),value);
+         PvaClientExecutor::dispatch(pvaClient,this,req,&PvaClientChannelStateChangeRequester::channelStateChange,
+             PvaClientChannelPtr(shared_from_this()),value);
+    }
+    std::vector<PvaClientChannelStateChangeRequesterPtr> listeners;
+    {
+        Lock xx(mutex);
+        size_t num = 0;
+        for(size_t i=0; i<stateChangeListeners.size(); ++i) {
+            PvaClientChannelStateChangeRequesterPtr listener(stateChangeListeners[i].lock());
+            if(!listener) continue;
+            stateChangeListeners[num++] = stateChangeListeners[i];
+            listeners.push_back(listener);
+        }
+        stateChangeListeners.resize(num);
+    }
+    for(size_t i=0; i<listeners.size(); ++i) {
+         PvaClientExecutor::dispatch(pvaClient,this,listeners[i],
+             &PvaClientChannelStateChangeRequester::channelStateChange,
+             PvaClientChannelPtr(shared_from_this()),value);
     }
 }
 
@@ -251,6 +543,30 @@ void PvaClientChannel::setStateChangeRequester(
     stateChangeRequester->channelStateChange(shared_from_this(),isConnected);
 }
 
+void PvaClientChannel::addStateChangeListener(
+    PvaClientChannelStateChangeRequesterPtr const & listener)
+{
+    {
+        Lock xx(mutex);
+        stateChangeListeners.push_back(listener);
+    }
+    bool isConnected = false;
+    if(channel) isConnected = channel->isConnected();
+    listener->channelStateChange(shared_from_this(),isConnected);
+}
+
+void PvaClientChannel::removeStateChangeListener(
+    PvaClientChannelStateChangeRequesterPtr const & listener)
+{
+    Lock xx(mutex);
+    for(size_t i=0; i<stateChangeListeners.size(); ++i) {
+        if(stateChangeListeners[i].lock()==listener) {
+            stateChangeListeners.erase(stateChangeListeners.begin()+i);
+            return;
+        }
+    }
+}
+
 void PvaClientChannel::connect(double timeout)
 {
     if(PvaClient::getDebug()) {
@@ -313,15 +629,84 @@ Status PvaClientChannel::waitConnect(double timeout)
     return Status(Status::STATUSTYPE_ERROR," not connected");
 }
 
-PvaClientProcessPtr PvaClientChannel::createProcess(string const & request)
+PvaClientFuturePtr PvaClientChannel::connectAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientChannel::connectAsync"
+        << " channelName " << channelName << endl;
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    bool isConnected = true;
+    bool isIdle = false;
+    {
+        Lock xx(mutex);
+        if(connectState!=connected) {
+            isConnected = false;
+            if(connectFuture) {
+                string message = string("channel ") + channelName
+                    + " PvaClientChannel::connectAsync connect aleady active";
+                throw std::runtime_error(message);
+            }
+            future->setOwner(shared_from_this());
+            connectFuture = future;
+            isIdle = (connectState==connectIdle);
+        }
+    }
+    if(isConnected) {
+        future->complete(Status::Ok);
+        return future;
+    }
+    if(!isIdle) return future;
+    try {
+        issueConnect();
+    } catch (...) {
+        Lock xx(mutex);
+        connectFuture.reset();
+        throw;
+    }
+    return future;
+}
+
+void PvaClientChannel::setConnectLatch(PvaClientConnectLatchPtr const & latch)
+{
+    Lock xx(mutex);
+    connectLatch = latch;
+}
+
+void PvaClientChannel::releaseConnectLatch()
+{
+    PvaClientConnectLatchPtr latch;
+    {
+        Lock xx(mutex);
+        latch.swap(connectLatch);
+    }
+    if(latch) latch->countDown();
+}
+
+bool PvaClientChannel::isChannelConnected()
+{
+    Lock xx(mutex);
+    return connectState==connected;
+}
+
+PVStructurePtr PvaClientChannel::createPVRequest(
+    string const & request,
+    string const & method)
 {
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
+    PvaClientPtr yyy = pvaClient.lock();
+    if(!yyy) throw std::runtime_error("PvaClient was destroyed");
+    try {
+        return yyy->createRequest(request);
+    } catch (std::exception& e) {
         string message = string("channel ") + channelName
-            + " PvaClientChannel::createProcess invalid pvRequest: "
-            + createRequest->getMessage();
+            + " PvaClientChannel::" + method + " " + e.what();
         throw std::runtime_error(message);
     }
+}
+
+PvaClientProcessPtr PvaClientChannel::createProcess(string const & request)
+{
+    PVStructurePtr pvRequest = createPVRequest(request,"createProcess");
     return createProcess(pvRequest);
 }
 
@@ -336,26 +721,38 @@ PvaClientProcessPtr PvaClientChannel::createProcess(PVStructurePtr const &  pvRe
 
 PvaClientGetPtr PvaClientChannel::get(string const & request)
 {
-    PvaClientGetPtr pvaClientGet = pvaClientGetCache->getGet(request);
-    if(!pvaClientGet) {
-        pvaClientGet = createGet(request);
-        pvaClientGet->connect();
-        pvaClientGetCache->addGet(request,pvaClientGet);
+    bool estimate = false;
+    PvaClientGetPtr pvaClientGet = pvaClientGetCache->getRequest(request,&estimate);
+    if(pvaClientGet) {
+        pvaClientGet->get();
+        if(estimate) {
+            pvaClientGetCache->setBytes(
+                request,pvFieldBytes(pvaClientGet->getData()->getPVStructure()));
+        }
+        return pvaClientGet;
     }
+    pvaClientGet = createGet(request);
+    pvaClientGet->connect();
+    pvaClientGet = pvaClientGetCache->addRequest(request,pvaClientGet);
     pvaClientGet->get();
+    PvaClientPtr yyy = pvaClient.lock();
+    if(yyy) {
+        PvaClientCacheLimits limits(yyy->getRequestCacheLimits());
+        // the size is only needed, and only estimated, for a byte budget
+        bool estimateBytes = needBytes(yyy,limits);
+        if(estimateBytes) {
+            pvaClientGetCache->setBytes(
+                request,pvFieldBytes(pvaClientGet->getData()->getPVStructure()));
+        }
+        pvaClientGetCache->sweep(limits,false);
+    }
     return pvaClientGet;
 }
 
 
 PvaClientGetPtr PvaClientChannel::createGet(string const & request)
 {
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = string("channel ") + channelName
-            + " PvaClientChannel::createGet invalid pvRequest: "
-            + createRequest->getMessage();
-        throw std::runtime_error(message);
-    }
+    PVStructurePtr pvRequest = createPVRequest(request,"createGet");
     return createGet(pvRequest);
 }
 
@@ -367,36 +764,125 @@ PvaClientGetPtr PvaClientChannel::createGet(PVStructurePtr const &  pvRequest)
     return PvaClientGet::create(yyy,shared_from_this(),pvRequest);
 }
 
+PvaClientFuturePtr PvaClientChannel::getAsync(string const & request)
+{
+    PvaClientGetPtr pvaClientGet = pvaClientGetCache->getRequest(request);
+    if(!pvaClientGet) {
+        pvaClientGet = createGet(request);
+        pvaClientGet->connect();
+        pvaClientGet = pvaClientGetCache->addRequest(request,pvaClientGet);
+        PvaClientPtr yyy = pvaClient.lock();
+        if(yyy) pvaClientGetCache->sweep(yyy->getRequestCacheLimits(),false);
+    }
+    return pvaClientGet->getAsync();
+}
+
+PvaClientGetPipelinePtr PvaClientChannel::createGetPipeline(
+    string const & request,
+    size_t depth)
+{
+    PVStructurePtr pvRequest = createPVRequest(request,"createGetPipeline");
+    return createGetPipeline(pvRequest,depth);
+}
+
+PvaClientGetPipelinePtr PvaClientChannel::createGetPipeline(
+    PVStructurePtr const &  pvRequest,
+    size_t depth)
+{
+    if(connectState!=connected) connect(5.0);
+    PvaClientPtr yyy = pvaClient.lock();
+    if(!yyy) throw std::runtime_error("PvaClient was destroyed");
+    return PvaClientGetPipeline::create(yyy,shared_from_this(),pvRequest,depth);
+}
+
+template<typename T>
+T PvaClientChannel::readValue(string const & request,T (PvaClientData::*getter)())
+{
+    PvaClientReadCachePtr readCache;
+    {
+        Lock xx(mutex);
+        readCache = pvaClientReadCache;
+    }
+    if(!readCache || !isChannelConnected()) {
+        return ((*get(request)->getData()).*getter)();
+    }
+    PvaClientReadCacheEntryPtr entry(readCache->getEntry(request,shared_from_this()));
+    T value;
+    if(entry->read(getter,readCache->getMaxAge(),value)) return value;
+    value = ((*get(request)->getData()).*getter)();
+    // the monitor is connected, so without an event the value has not changed
+    entry->touch();
+    return value;
+}
+
 double PvaClientChannel::getDouble(string const & request)
 {
-     return get(request)->getData()->getDouble();
+    return readValue(request,&PvaClientData::getDouble);
 }
 
 string PvaClientChannel::getString(string const & request)
 {
-    return get(request)->getData()->getString();
+    return readValue(request,&PvaClientData::getString);
 }
 
 shared_vector<const double>  PvaClientChannel::getDoubleArray(string const & request)
 {
-    return get(request)->getData()->getDoubleArray();
+    return readValue(request,&PvaClientData::getDoubleArray);
 }
 
 shared_vector<const std::string>  PvaClientChannel::getStringArray(string const & request)
 {
-    return get(request)->getData()->getStringArray();
+    return readValue(request,&PvaClientData::getStringArray);
+}
+
+void PvaClientChannel::enableReadCache(double maxAge)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientChannel::enableReadCache channelName " << channelName
+             << " maxAge " << maxAge << endl;
+    }
+    PvaClientReadCachePtr readCache(new PvaClientReadCache(maxAge));
+    Lock xx(mutex);
+    pvaClientReadCache.swap(readCache);
+}
+
+void PvaClientChannel::disableReadCache()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientChannel::disableReadCache channelName " << channelName << endl;
+    }
+    PvaClientReadCachePtr readCache;
+    Lock xx(mutex);
+    pvaClientReadCache.swap(readCache);
 }
 
 
 PvaClientPutPtr PvaClientChannel::put(string const & request)
 {
-    PvaClientPutPtr pvaClientPut = pvaClientPutCache->getPut(request);
-    if(pvaClientPut) return pvaClientPut;
+    bool estimate = false;
+    PvaClientPutPtr pvaClientPut = pvaClientPutCache->getRequest(request,&estimate);
+    if(pvaClientPut) {
+        if(estimate) {
+            pvaClientPutCache->setBytes(
+                request,pvFieldBytes(pvaClientPut->getData()->getPVStructure()));
+        }
+        return pvaClientPut;
+    }
     if(!pvaClientPut) {
         pvaClientPut = createPut(request);
         pvaClientPut->connect();
         pvaClientPut->get();
-        pvaClientPutCache->addPut(request,pvaClientPut);
+        pvaClientPut = pvaClientPutCache->addRequest(request,pvaClientPut);
+        PvaClientPtr yyy = pvaClient.lock();
+        if(yyy) {
+            PvaClientCacheLimits limits(yyy->getRequestCacheLimits());
+            bool estimateBytes = needBytes(yyy,limits);
+            if(estimateBytes) {
+                pvaClientPutCache->setBytes(
+                    request,pvFieldBytes(pvaClientPut->getData()->getPVStructure()));
+            }
+            pvaClientPutCache->sweep(limits,false);
+        }
     }
     return pvaClientPut;
 }
@@ -404,13 +890,7 @@ PvaClientPutPtr PvaClientChannel::put(string const & request)
 
 PvaClientPutPtr PvaClientChannel::createPut(string const & request)
 {
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = string("channel ") + channelName
-            + " PvaClientChannel::createPut invalid pvRequest: "
-            + createRequest->getMessage();
-        throw std::runtime_error(message);
-    }
+    PVStructurePtr pvRequest = createPVRequest(request,"createPut");
     return createPut(pvRequest);
 }
 
@@ -442,10 +922,7 @@ void PvaClientChannel::putDoubleArray(
 {
     PvaClientPutPtr clientPut = put(request);
     PvaClientPutDataPtr putData = clientPut->getData();
-    size_t n = value.size();
-    shared_vector<double> valueArray(n);
-    for(size_t i=0; i<n; ++i) valueArray[i] = value[i];
-    putData->putDoubleArray(freeze(valueArray)); clientPut->put();
+    putData->putDoubleArray(value); clientPut->put();
 }
 
 void PvaClientChannel::putStringArray(
@@ -454,21 +931,39 @@ void PvaClientChannel::putStringArray(
 {
     PvaClientPutPtr clientPut = put(request);
     PvaClientPutDataPtr putData = clientPut->getData();
-    size_t n = value.size();
-    shared_vector<string> valueArray(n);
-    for(size_t i=0; i<n; ++i) valueArray[i] = value[i];
-    putData->putStringArray(freeze(valueArray)); clientPut->put();
+    putData->putStringArray(value); clientPut->put();
+}
+
+void PvaClientChannel::moveDoubleArray(
+    shared_vector<double> & value,
+    string const & request)
+{
+    PvaClientPutPtr clientPut = put(request);
+    PvaClientPutDataPtr putData = clientPut->getData();
+    putData->moveDoubleArray(value); clientPut->put();
+}
+
+void PvaClientChannel::moveStringArray(
+    shared_vector<string> & value,
+    string const & request)
+{
+    PvaClientPutPtr clientPut = put(request);
+    PvaClientPutDataPtr putData = clientPut->getData();
+    putData->moveStringArray(value); clientPut->put();
+}
+
+void PvaClientChannel::moveStringArray(
+    std::vector<string> & value,
+    string const & request)
+{
+    PvaClientPutPtr clientPut = put(request);
+    PvaClientPutDataPtr putData = clientPut->getData();
+    putData->moveStringArray(value); clientPut->put();
 }
 
 PvaClientPutGetPtr PvaClientChannel::createPutGet(string const & request)
 {
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = string("channel ") + channelName
-            + " PvaClientChannel::createPutGet invalid pvRequest: "
-            + createRequest->getMessage();
-        throw std::runtime_error(message);
-    }
+    PVStructurePtr pvRequest = createPVRequest(request,"createPutGet");
     return createPutGet(pvRequest);
 }
 
@@ -505,13 +1000,7 @@ PvaClientMonitorPtr PvaClientChannel::monitor(string const & request,
 
 PvaClientMonitorPtr PvaClientChannel::createMonitor(string const & request)
 {
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = string("channel ") + channelName
-            + " PvaClientChannel::createMonitor invalid pvRequest: "
-            + createRequest->getMessage();
-        throw std::runtime_error(message);
-    }
+    PVStructurePtr pvRequest = createPVRequest(request,"createMonitor");
     return createMonitor(pvRequest);
 }
 
@@ -576,6 +1065,20 @@ size_t PvaClientChannel::cacheSize()
     return pvaClientGetCache->cacheSize() + pvaClientPutCache->cacheSize();
 }
 
+PvaClientCacheStats PvaClientChannel::getCacheStats()
+{
+    PvaClientCacheStats stats;
+    pvaClientGetCache->addStats(stats);
+    pvaClientPutCache->addStats(stats);
+    return stats;
+}
+
+void PvaClientChannel::sweepCache(PvaClientCacheLimits const & limits,bool reestimate)
+{
+    pvaClientGetCache->sweep(limits,reestimate);
+    pvaClientPutCache->sweep(limits,reestimate);
+}
+
 
 
 }}
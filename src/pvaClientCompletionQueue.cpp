@@ -0,0 +1,204 @@
+/* pvaClientCompletionQueue.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <sstream>
+#include <epicsAtomic.h>
+#include <epicsThread.h>
+#include <pv/event.h>
+#include <pv/lock.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClient.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+struct PvaClientCompletionQueue::Node
+{
+    Node() : next(0) {}
+    EpicsAtomicPtrT next;
+    PvaClientFuturePtr future;
+    std::vector<PvaClientFutureRequesterPtr> requesters;
+};
+
+PvaClientCompletionQueuePtr PvaClientCompletionQueue::create(size_t numberThreads)
+{
+    if(numberThreads<1) numberThreads = 1;
+    PvaClientCompletionQueuePtr queue(new PvaClientCompletionQueue(numberThreads));
+    queue->self = queue;
+    for(size_t i=0; i<numberThreads; ++i) queue->threads[i]->start();
+    return queue;
+}
+
+PvaClientCompletionQueue::PvaClientCompletionQueue(size_t numberThreads)
+: head(0),
+  tail(0),
+  stub(new Node()),
+  pending(0),
+  waiting(0),
+  stopping(0)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientCompletionQueue::PvaClientCompletionQueue numberThreads "
+             << numberThreads << endl;
+    }
+    head = stub;
+    tail = stub;
+    for(size_t i=0; i<numberThreads; ++i) {
+        stringstream name;
+        name << "pvaClientCompletion" << i;
+        threads.push_back(std::tr1::shared_ptr<epicsThread>(new epicsThread(
+            *this,
+            name.str().c_str(),
+            epicsThreadGetStackSize(epicsThreadStackSmall),
+            epicsThreadPriorityMedium)));
+    }
+    threadDestroyed.resize(numberThreads,0);
+}
+
+PvaClientCompletionQueue::~PvaClientCompletionQueue()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientCompletionQueue::~PvaClientCompletionQueue\n";
+    epicsAtomicSetSizeT(&stopping,1);
+    waitForWork.signal();
+    for(size_t i=0; i<threads.size(); ++i) {
+        if(threads[i]->isCurrentThread()) {
+            // futureDone released the last reference; run returns without touching this
+            *threadDestroyed[i] = true;
+            continue;
+        }
+        threads[i]->exitWait();
+    }
+    // the other threads have exited, so nothing else removes nodes
+    while(Node * node = pop()) deliver(node);
+    threads.clear();
+    delete stub;
+}
+
+size_t PvaClientCompletionQueue::getNumberThreads()
+{
+    return threads.size();
+}
+
+size_t PvaClientCompletionQueue::getPending()
+{
+    return epicsAtomicGetSizeT(&pending);
+}
+
+void PvaClientCompletionQueue::push(
+    PvaClientFuturePtr const & future,
+    std::vector<PvaClientFutureRequesterPtr> const & requesters)
+{
+    Node * node = new Node();
+    node->future = future;
+    node->requesters = requesters;
+    epicsAtomicIncrSizeT(&pending);
+    // swap the node in as the new head, then link the previous head to it
+    EpicsAtomicPtrT prev = epicsAtomicGetPtrT(&head);
+    while(true) {
+        EpicsAtomicPtrT old = epicsAtomicCmpAndSwapPtrT(&head,prev,node);
+        if(old==prev) break;
+        prev = old;
+    }
+    epicsAtomicSetPtrT(&static_cast<Node *>(prev)->next,node);
+    if(epicsAtomicGetSizeT(&waiting)>0) waitForWork.signal();
+}
+
+// caller must hold consumerMutex; returns 0 if the list is empty
+PvaClientCompletionQueue::Node * PvaClientCompletionQueue::pop()
+{
+    Node * first = tail;
+    Node * next = static_cast<Node *>(epicsAtomicGetPtrT(&first->next));
+    if(first==stub) {
+        // a push is in progress or the list is empty
+        if(!next) return 0;
+        tail = next;
+        first = next;
+        next = static_cast<Node *>(epicsAtomicGetPtrT(&first->next));
+    }
+    if(next) {
+        tail = next;
+        return first;
+    }
+    if(first!=epicsAtomicGetPtrT(&head)) return 0;
+    // first is the only node; put the stub behind it so it can be removed
+    epicsAtomicSetPtrT(&stub->next,0);
+    EpicsAtomicPtrT prev = epicsAtomicGetPtrT(&head);
+    while(true) {
+        EpicsAtomicPtrT old = epicsAtomicCmpAndSwapPtrT(&head,prev,stub);
+        if(old==prev) break;
+        prev = old;
+    }
+    epicsAtomicSetPtrT(&static_cast<Node *>(prev)->next,stub);
+    next = static_cast<Node *>(epicsAtomicGetPtrT(&first->next));
+    if(next) {
+        tail = next;
+        return first;
+    }
+    return 0;
+}
+
+void PvaClientCompletionQueue::deliver(Node * node)
+{
+    for(size_t i=0; i<node->requesters.size(); ++i) {
+        try {
+            node->requesters[i]->futureDone(node->future);
+        } catch (std::exception& e) {
+            cerr << "PvaClientCompletionQueue futureDone exception " << e.what() << endl;
+        } catch (...) {
+            cerr << "PvaClientCompletionQueue futureDone unknown exception" << endl;
+        }
+    }
+    delete node;
+}
+
+void PvaClientCompletionQueue::run()
+{
+    bool destroyed = false;
+    for(size_t i=0; i<threads.size(); ++i) {
+        if(threads[i]->isCurrentThread()) threadDestroyed[i] = &destroyed;
+    }
+    while(true) {
+        Node * node = 0;
+        {
+            Lock xx(consumerMutex);
+            node = pop();
+        }
+        if(node) {
+            epicsAtomicDecrSizeT(&pending);
+            // the event only holds one signal; pass it on if more work is queued
+            if(epicsAtomicGetSizeT(&pending)>0 && epicsAtomicGetSizeT(&waiting)>0) {
+                waitForWork.signal();
+            }
+            PvaClientCompletionQueuePtr guard(self.lock());
+            deliver(node);
+            // if futureDone released the last reference the destructor runs here
+            guard.reset();
+            if(destroyed) return;
+            continue;
+        }
+        // push holds a reference, so once stopping no push is in progress
+        if(epicsAtomicGetSizeT(&stopping)) break;
+        epicsAtomicIncrSizeT(&waiting);
+        // check again after announcing the wait so that a push cannot be missed
+        if(epicsAtomicGetSizeT(&pending)==0 && !epicsAtomicGetSizeT(&stopping)) {
+            waitForWork.wait();
+        }
+        epicsAtomicDecrSizeT(&waiting);
+    }
+    // wake the next thread so all threads see stopping
+    waitForWork.signal();
+}
+
+}}
@@ -0,0 +1,269 @@
+/* pvaClientConvert.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP>=2)
+#  include <emmintrin.h>
+#  define PVACLIENT_CONVERT_SSE2
+#endif
+
+// AVX2 code is compiled for a target attribute and selected at run time
+#if defined(PVACLIENT_CONVERT_SSE2) && (defined(__x86_64__) || defined(__i386__)) \
+    && ((defined(__GNUC__) && (__GNUC__>4 || (__GNUC__==4 && __GNUC_MINOR__>=9))) || defined(__clang__))
+#  include <immintrin.h>
+#  define PVACLIENT_CONVERT_AVX2
+#  define PVACLIENT_AVX2 __attribute__((target("avx2")))
+#endif
+
+#define epicsExportSharedSymbols
+
+#include "pvaClientConvert.h"
+
+using std::tr1::static_pointer_cast;
+using namespace epics::pvData;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+#ifdef PVACLIENT_CONVERT_AVX2
+
+static bool haveAVX2()
+{
+    // asked once, not for every array
+    static const bool avx2 = __builtin_cpu_supports("avx2") ? true : false;
+    return avx2;
+}
+
+PVACLIENT_AVX2
+static size_t toDoubleAVX2(const int16 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+8<=length; i+=8) {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(from+i)));
+        _mm256_storeu_pd(to+i,_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+        _mm256_storeu_pd(to+i+4,_mm256_cvtepi32_pd(_mm256_extracti128_si256(v,1)));
+    }
+    return i;
+}
+
+PVACLIENT_AVX2
+static size_t toDoubleAVX2(const uint16 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+8<=length; i+=8) {
+        __m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(from+i)));
+        _mm256_storeu_pd(to+i,_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)));
+        _mm256_storeu_pd(to+i+4,_mm256_cvtepi32_pd(_mm256_extracti128_si256(v,1)));
+    }
+    return i;
+}
+
+PVACLIENT_AVX2
+static size_t toDoubleAVX2(const int32 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        _mm256_storeu_pd(to+i,_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(from+i))));
+    }
+    return i;
+}
+
+PVACLIENT_AVX2
+static size_t toDoubleAVX2(const float * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        _mm256_storeu_pd(to+i,_mm256_cvtps_pd(_mm_loadu_ps(from+i)));
+    }
+    return i;
+}
+
+PVACLIENT_AVX2
+static size_t toFloatAVX2(const double * from,float * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        _mm_storeu_ps(to+i,_mm256_cvtpd_ps(_mm256_loadu_pd(from+i)));
+    }
+    return i;
+}
+
+#endif  /* PVACLIENT_CONVERT_AVX2 */
+
+#ifdef PVACLIENT_CONVERT_SSE2
+
+static size_t toDoubleSSE2(const int16 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+8<=length; i+=8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(from+i));
+        // put each value in the high half of an int32 and shift back to sign extend
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v,v),16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v,v),16);
+        _mm_storeu_pd(to+i,_mm_cvtepi32_pd(lo));
+        _mm_storeu_pd(to+i+2,_mm_cvtepi32_pd(_mm_shuffle_epi32(lo,0x4e)));
+        _mm_storeu_pd(to+i+4,_mm_cvtepi32_pd(hi));
+        _mm_storeu_pd(to+i+6,_mm_cvtepi32_pd(_mm_shuffle_epi32(hi,0x4e)));
+    }
+    return i;
+}
+
+static size_t toDoubleSSE2(const uint16 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    __m128i zero = _mm_setzero_si128();
+    for(; i+8<=length; i+=8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(from+i));
+        __m128i lo = _mm_unpacklo_epi16(v,zero);
+        __m128i hi = _mm_unpackhi_epi16(v,zero);
+        _mm_storeu_pd(to+i,_mm_cvtepi32_pd(lo));
+        _mm_storeu_pd(to+i+2,_mm_cvtepi32_pd(_mm_shuffle_epi32(lo,0x4e)));
+        _mm_storeu_pd(to+i+4,_mm_cvtepi32_pd(hi));
+        _mm_storeu_pd(to+i+6,_mm_cvtepi32_pd(_mm_shuffle_epi32(hi,0x4e)));
+    }
+    return i;
+}
+
+static size_t toDoubleSSE2(const int32 * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(from+i));
+        _mm_storeu_pd(to+i,_mm_cvtepi32_pd(v));
+        _mm_storeu_pd(to+i+2,_mm_cvtepi32_pd(_mm_shuffle_epi32(v,0x4e)));
+    }
+    return i;
+}
+
+static size_t toDoubleSSE2(const float * from,double * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        __m128 v = _mm_loadu_ps(from+i);
+        _mm_storeu_pd(to+i,_mm_cvtps_pd(v));
+        _mm_storeu_pd(to+i+2,_mm_cvtps_pd(_mm_movehl_ps(v,v)));
+    }
+    return i;
+}
+
+static size_t toFloatSSE2(const double * from,float * to,size_t length)
+{
+    size_t i = 0;
+    for(; i+4<=length; i+=4) {
+        __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(from+i));
+        __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(from+i+2));
+        _mm_storeu_ps(to+i,_mm_movelh_ps(lo,hi));
+    }
+    return i;
+}
+
+#endif  /* PVACLIENT_CONVERT_SSE2 */
+
+// the vector loops convert a multiple of their width; the rest is done here
+template<typename From,typename To>
+static size_t convertVector(const From * from,To * to,size_t length)
+{
+#ifdef PVACLIENT_CONVERT_AVX2
+    if(haveAVX2()) return toDoubleAVX2(from,to,length);
+#endif
+#ifdef PVACLIENT_CONVERT_SSE2
+    return toDoubleSSE2(from,to,length);
+#else
+    return 0;
+#endif
+}
+
+template<>
+size_t convertVector<double,float>(const double * from,float * to,size_t length)
+{
+#ifdef PVACLIENT_CONVERT_AVX2
+    if(haveAVX2()) return toFloatAVX2(from,to,length);
+#endif
+#ifdef PVACLIENT_CONVERT_SSE2
+    return toFloatSSE2(from,to,length);
+#else
+    return 0;
+#endif
+}
+
+template<typename From,typename To>
+static void convert(const From * from,To * to,size_t length)
+{
+    size_t i = convertVector(from,to,length);
+    for(; i<length; ++i) to[i] = static_cast<To>(from[i]);
+}
+
+void PvaClientConvert::toDouble(const int16 * from,double * to,size_t length)
+{
+    convert(from,to,length);
+}
+
+void PvaClientConvert::toDouble(const uint16 * from,double * to,size_t length)
+{
+    convert(from,to,length);
+}
+
+void PvaClientConvert::toDouble(const int32 * from,double * to,size_t length)
+{
+    convert(from,to,length);
+}
+
+void PvaClientConvert::toDouble(const float * from,double * to,size_t length)
+{
+    convert(from,to,length);
+}
+
+void PvaClientConvert::toFloat(const double * from,float * to,size_t length)
+{
+    convert(from,to,length);
+}
+
+template<typename T>
+static shared_vector<const double> arrayToDouble(PVScalarArrayPtr const & pvScalarArray)
+{
+    shared_vector<const T> from(static_pointer_cast<PVValueArray<T> >(pvScalarArray)->view());
+    shared_vector<double> to(from.size());
+    PvaClientConvert::toDouble(from.data(),to.data(),from.size());
+    return freeze(to);
+}
+
+bool PvaClientConvert::getDoubleArray(
+    PVScalarArrayPtr const & pvScalarArray,
+    shared_vector<const double> & value)
+{
+    switch(pvScalarArray->getScalarArray()->getElementType()) {
+    case pvShort:
+        value = arrayToDouble<int16>(pvScalarArray);
+        return true;
+    case pvUShort:
+        value = arrayToDouble<uint16>(pvScalarArray);
+        return true;
+    case pvInt:
+        value = arrayToDouble<int32>(pvScalarArray);
+        return true;
+    case pvFloat:
+        value = arrayToDouble<float>(pvScalarArray);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool PvaClientConvert::putDoubleArray(
+    PVScalarArrayPtr const & pvScalarArray,
+    shared_vector<const double> const & value)
+{
+    if(pvScalarArray->getScalarArray()->getElementType()!=pvFloat) return false;
+    shared_vector<float> to(value.size());
+    toFloat(value.data(),to.data(),value.size());
+    static_pointer_cast<PVFloatArray>(pvScalarArray)->replace(freeze(to));
+    return true;
+}
+
+}}
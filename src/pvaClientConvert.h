@@ -0,0 +1,64 @@
+/* pvaClientConvert.h */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+#ifndef PVACLIENTCONVERT_H
+#define PVACLIENTCONVERT_H
+
+#ifdef epicsExportSharedSymbols
+#   define pvaClientConvertEpicsExportSharedSymbols
+#   undef epicsExportSharedSymbols
+#endif
+
+#include <pv/pvData.h>
+
+#ifdef pvaClientConvertEpicsExportSharedSymbols
+#   define epicsExportSharedSymbols
+#   undef pvaClientConvertEpicsExportSharedSymbols
+#endif
+
+namespace epics { namespace pvaClient {
+
+/**
+ * @brief Conversion of numeric arrays to and from double for the pvaClient array accessors.
+ *
+ * This is not installed; it is used by the implementation and the tests only.
+ * On x86 the loops use SSE2, and AVX2 when the processor supports it.
+ * Otherwise a plain loop is used.
+ */
+class epicsShareClass PvaClientConvert
+{
+public:
+    static void toDouble(const epics::pvData::int16 * from,double * to,size_t length);
+    static void toDouble(const epics::pvData::uint16 * from,double * to,size_t length);
+    static void toDouble(const epics::pvData::int32 * from,double * to,size_t length);
+    static void toDouble(const float * from,double * to,size_t length);
+    static void toFloat(const double * from,float * to,size_t length);
+    /** @brief Get a scalar array as double.
+     *
+     * @param pvScalarArray The array.
+     * @param value Set to the converted array.
+     * @return (false,true) if the element type (does not have, has) a fast conversion.
+     */
+    static bool getDoubleArray(
+        epics::pvData::PVScalarArrayPtr const & pvScalarArray,
+        epics::pvData::shared_vector<const double> & value);
+    /** @brief Put a double array into a scalar array.
+     *
+     * @param pvScalarArray The array.
+     * @param value The data.
+     * @return (false,true) if the element type (does not have, has) a fast conversion.
+     */
+    static bool putDoubleArray(
+        epics::pvData::PVScalarArrayPtr const & pvScalarArray,
+        epics::pvData::shared_vector<const double> const & value);
+};
+
+}}
+
+#endif  /* PVACLIENTCONVERT_H */
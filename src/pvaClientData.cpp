@@ -26,6 +26,7 @@
 #define epicsExportSharedSymbols
 
 #include <pv/pvaClient.h>
+#include "pvaClientConvert.h"
 
 using std::tr1::static_pointer_cast;
 using namespace epics::pvData;
@@ -52,17 +53,35 @@ PvaClientDataPtr PvaClientData::create(StructureConstPtr const & structure)
     return epv;
 }
 
-PvaClientData::PvaClientData(StructureConstPtr const & structure)
-: structure(structure)
+PvaClientFieldPath::PvaClientFieldPath(string const & path)
+: path(path),
+  offset(0)
 {
 }
 
-PVFieldPtr PvaClientData::getSinglePVField()
+string PvaClientFieldPath::getPath() const
 {
-    if(PvaClient::getDebug()) cout << "PvaClientData::getSinglePVField\n";
-    PVStructurePtr pvStructure = getPVStructure();
+    return path;
+}
+
+size_t PvaClientFieldPath::getOffset() const
+{
+    return offset;
+}
+
+size_t PvaClientFieldPath::resolve(PVStructurePtr const & pvStructure)
+{
+    PVFieldPtr pvField(path.empty() ? findSingleField(pvStructure) : pvStructure->getSubField(path));
+    offset = pvField ? pvField->getFieldOffset() : 0;
+    structure = pvStructure->getStructure();
+    return offset;
+}
+
+PVFieldPtr PvaClientFieldPath::findSingleField(PVStructurePtr const & top)
+{
+    PVStructurePtr pvStructure(top);
     while(true) {
-         const PVFieldPtrArray fieldPtrArray(pvStructure->getPVFields());
+         const PVFieldPtrArray & fieldPtrArray(pvStructure->getPVFields());
          if(fieldPtrArray.size()==0) {
               throw std::logic_error("PvaClientData::getSinglePVField() pvRequest for empty structure");
          }
@@ -81,6 +100,28 @@ PVFieldPtr PvaClientData::getSinglePVField()
     }
 }
 
+PvaClientData::PvaClientData(StructureConstPtr const & structure)
+: structure(structure),
+  valueField("value")
+{
+}
+
+PVFieldPtr PvaClientData::getSinglePVField()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientData::getSinglePVField\n";
+    return singleField.get(getPVStructure());
+}
+
+PVScalarArrayPtr PvaClientData::getSingleScalarArray(const char * method)
+{
+    PVFieldPtr pvField = getSinglePVField();
+    if(pvField->getField()->getType()!=scalarArray) {
+        throw std::logic_error(
+            string("PvaClientData::") + method + "() did not find a scalarArray field");
+    }
+    return static_pointer_cast<PVScalarArray>(pvField);
+}
+
 void PvaClientData::checkValue()
 {
     if(PvaClient::getDebug()) cout << "PvaClientData::checkValue\n";
@@ -135,7 +176,7 @@ void PvaClientData::setData(
    if(PvaClient::getDebug()) cout << "PvaClientData::setData\n";
    pvStructure = pvStructureFrom;
    bitSet = bitSetFrom;
-   pvValue = pvStructure->getSubField("value");
+   pvValue = valueField.get(pvStructure);
 }
 
 
@@ -176,7 +217,7 @@ PVScalarPtr  PvaClientData::getScalarValue()
     if(pvValue->getField()->getType()!=scalar) {
        throw std::runtime_error(messagePrefix + noScalar);
     }
-    return pvStructure->getSubField<PVScalar>("value");
+    return static_pointer_cast<PVScalar>(pvValue);
 }
 
 PVArrayPtr  PvaClientData::getArrayValue()
@@ -187,7 +228,7 @@ PVArrayPtr  PvaClientData::getArrayValue()
     if(type!=scalarArray && type!=structureArray && type!=unionArray) {
         throw std::runtime_error(messagePrefix + noArray);
     }
-    return pvStructure->getSubField<PVArray>("value");
+    return static_pointer_cast<PVArray>(pvValue);
 }
 
 PVScalarArrayPtr  PvaClientData::getScalarArrayValue()
@@ -198,7 +239,7 @@ PVScalarArrayPtr  PvaClientData::getScalarArrayValue()
     if(type!=scalarArray) {
         throw std::runtime_error(messagePrefix + noScalarArray);
     }
-    return pvStructure->getSubField<PVScalarArray>("value");
+    return static_pointer_cast<PVScalarArray>(pvValue);
 }
 
 double PvaClientData::getDouble()
@@ -249,6 +290,7 @@ shared_vector<const double> PvaClientData::getDoubleArray()
             "PvaClientData::getDoubleArray() did not find a numeric scalarArray field");
     }
     shared_vector<const double> retValue;
+    if(PvaClientConvert::getDoubleArray(pvScalarArray,retValue)) return retValue;
     pvScalarArray->getAs<const double>(retValue);
     return retValue;
 }
@@ -267,6 +309,12 @@ shared_vector<const string> PvaClientData::getStringArray()
     return retValue;
 }
 
+ScalarType PvaClientData::getArrayElementType()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientData::getArrayElementType\n";
+    return getSingleScalarArray("getArrayElementType")->getScalarArray()->getElementType();
+}
+
 Alarm PvaClientData::getAlarm()
 {
    if(PvaClient::getDebug()) cout << "PvaClientData::getAlarm\n";
@@ -374,6 +422,7 @@ void PvaClientData::parse(const std::vector<std::string> &args)
              for(size_t i=0; i<choices.size(); ++i) {
                   if(choices[i]==rest) {
                      pvEnumerated.setIndex(i);
+                     bitSet->set(pvField->getFieldOffset());
                      return;
                   }
              }
@@ -0,0 +1,197 @@
+/* pvaClientExecutor.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <sstream>
+#include <epicsThread.h>
+#include <pv/event.h>
+#include <pv/lock.h>
+#include <pv/timeStamp.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClient.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+struct PvaClientExecutor::Strand
+{
+    struct Entry
+    {
+        PvaClientExecutorTaskPtr task;
+        TimeStamp queueTime;
+    };
+    Strand(void const * key) : key(key), running(false) {}
+    void const * key;
+    std::deque<Entry> entries;
+    bool running;
+};
+
+PvaClientExecutorPtr PvaClientExecutor::create(
+    size_t numberThreads,
+    size_t maxQueued,
+    unsigned int priority)
+{
+    if(numberThreads<1) numberThreads = 1;
+    PvaClientExecutorPtr executor(new PvaClientExecutor(numberThreads,maxQueued,priority));
+    for(size_t i=0; i<numberThreads; ++i) executor->threads[i]->start();
+    return executor;
+}
+
+PvaClientExecutor::PvaClientExecutor(
+    size_t numberThreads,
+    size_t maxQueued,
+    unsigned int priority)
+: maxQueued(maxQueued),
+  stopping(false)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientExecutor::PvaClientExecutor"
+             << " numberThreads " << numberThreads
+             << " maxQueued " << maxQueued
+             << " priority " << priority
+             << endl;
+    }
+    for(size_t i=0; i<numberThreads; ++i) {
+        stringstream name;
+        name << "pvaClientExecutor" << i;
+        threads.push_back(std::tr1::shared_ptr<epicsThread>(new epicsThread(
+            *this,
+            name.str().c_str(),
+            epicsThreadGetStackSize(epicsThreadStackMedium),
+            priority)));
+    }
+}
+
+PvaClientExecutor::~PvaClientExecutor()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientExecutor::~PvaClientExecutor\n";
+    {
+        Lock xx(mutex);
+        stopping = true;
+    }
+    waitForWork.signal();
+    for(size_t i=0; i<threads.size(); ++i) threads[i]->exitWait();
+    threads.clear();
+    StrandMap::iterator iter;
+    for(iter = strandMap.begin(); iter != strandMap.end(); ++iter) delete iter->second;
+}
+
+PvaClientExecutorPtr PvaClientExecutor::getExecutor(PvaClient::weak_pointer const & pvaClient)
+{
+    PvaClientPtr client(pvaClient.lock());
+    if(!client) return PvaClientExecutorPtr();
+    return client->getExecutor();
+}
+
+void PvaClientExecutor::execute(void const * strand,PvaClientExecutorTaskPtr const & task)
+{
+    Strand::Entry entry;
+    entry.task = task;
+    Lock xx(mutex);
+    if(stopping) {
+        throw std::runtime_error("PvaClientExecutor::execute executor is stopping");
+    }
+    // the caller is usually a pvAccess network thread, so never wait for space
+    if(maxQueued>0 && stats.queued>=maxQueued) ++stats.overflowed;
+    entry.queueTime.getCurrent();
+    Strand * pstrand = 0;
+    StrandMap::iterator iter = strandMap.find(strand);
+    if(iter==strandMap.end()) {
+        pstrand = new Strand(strand);
+        strandMap.insert(StrandMap::value_type(strand,pstrand));
+    } else {
+        pstrand = iter->second;
+    }
+    pstrand->entries.push_back(entry);
+    ++stats.queued;
+    if(stats.queued>stats.maxQueued) stats.maxQueued = stats.queued;
+    if(!pstrand->running && pstrand->entries.size()==1) {
+        ready.push_back(pstrand);
+        waitForWork.signal();
+    }
+}
+
+size_t PvaClientExecutor::getNumberThreads()
+{
+    return threads.size();
+}
+
+size_t PvaClientExecutor::getMaxQueued()
+{
+    return maxQueued;
+}
+
+PvaClientExecutorStats PvaClientExecutor::getStats()
+{
+    Lock xx(mutex);
+    return stats;
+}
+
+void PvaClientExecutor::run()
+{
+    while(true) {
+        Strand * strand = 0;
+        Strand::Entry entry;
+        {
+            Lock xx(mutex);
+            while(ready.empty()) {
+                if(stopping && stats.queued==0) break;
+                xx.unlock();
+                waitForWork.wait();
+                xx.lock();
+            }
+            if(ready.empty()) break;
+            strand = ready.front();
+            ready.pop_front();
+            strand->running = true;
+            entry = strand->entries.front();
+            strand->entries.pop_front();
+            --stats.queued;
+            // the event only holds one signal; pass it on to an idle thread
+            if(!ready.empty()) waitForWork.signal();
+        }
+        TimeStamp startTime;
+        startTime.getCurrent();
+        try {
+            entry.task->run();
+        } catch (std::exception& e) {
+            cerr << "PvaClientExecutor task exception " << e.what() << endl;
+        } catch (...) {
+            cerr << "PvaClientExecutor task unknown exception" << endl;
+        }
+        entry.task.reset();
+        TimeStamp endTime;
+        endTime.getCurrent();
+        double waitTime = TimeStamp::diff(startTime,entry.queueTime);
+        double runTime = TimeStamp::diff(endTime,startTime);
+        Lock xx(mutex);
+        ++stats.executed;
+        stats.totalWaitTime += waitTime;
+        if(waitTime>stats.maxWaitTime) stats.maxWaitTime = waitTime;
+        stats.totalRunTime += runTime;
+        if(runTime>stats.maxRunTime) stats.maxRunTime = runTime;
+        strand->running = false;
+        if(strand->entries.empty()) {
+            strandMap.erase(strand->key);
+            delete strand;
+        } else {
+            ready.push_back(strand);
+            waitForWork.signal();
+        }
+    }
+    // wake the next thread so every thread sees stopping
+    waitForWork.signal();
+}
+
+}}
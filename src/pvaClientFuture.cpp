@@ -0,0 +1,204 @@
+/* pvaClientFuture.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <pv/event.h>
+#include <pv/lock.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClient.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+class PvaClientFutureWhenAll :
+    public PvaClientFutureRequester
+{
+public:
+    PvaClientFutureWhenAll(
+        PvaClientFuturePtr const & future,
+        size_t count)
+    : future(future),
+      count(count),
+      status(Status::Ok)
+    {}
+    virtual ~PvaClientFutureWhenAll() {
+        if(PvaClient::getDebug()) std::cout << "~PvaClientFutureWhenAll" << std::endl;
+    }
+    virtual void futureDone(PvaClientFuturePtr const & done)
+    {
+        Status result(done->getStatus());
+        {
+            Lock xx(mutex);
+            if(status.isOK() && !result.isOK()) status = result;
+            if(count==0) return;
+            --count;
+            if(count>0) return;
+            result = status;
+        }
+        future->complete(result);
+    }
+private:
+    PvaClientFuturePtr future;
+    Mutex mutex;
+    size_t count;
+    Status status;
+};
+
+PvaClientFuturePtr PvaClientFuture::create()
+{
+    PvaClientFuturePtr future(new PvaClientFuture());
+    return future;
+}
+
+PvaClientFuturePtr PvaClientFuture::whenAll(std::vector<PvaClientFuturePtr> const & futures)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientFuture::whenAll number " << futures.size() << endl;
+    PvaClientFuturePtr future(create());
+    if(futures.empty()) {
+        future->complete(Status::Ok);
+        return future;
+    }
+    PvaClientFutureRequesterPtr requester(new PvaClientFutureWhenAll(future,futures.size()));
+    for(size_t i=0; i<futures.size(); ++i) futures[i]->then(requester);
+    return future;
+}
+
+PvaClientFuture::PvaClientFuture()
+: done(false),
+  status(Status(Status::STATUSTYPE_ERROR,"request not complete"))
+{
+    if(PvaClient::getDebug()) cout << "PvaClientFuture::PvaClientFuture\n";
+}
+
+PvaClientFuture::~PvaClientFuture()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientFuture::~PvaClientFuture\n";
+}
+
+bool PvaClientFuture::isDone()
+{
+    Lock xx(mutex);
+    return done;
+}
+
+bool PvaClientFuture::wait(double timeout)
+{
+    EventPtr event;
+    {
+        Lock xx(mutex);
+        if(done) return true;
+        if(!waitForDone) waitForDone = EventPtr(new Event());
+        event = waitForDone;
+    }
+    if(timeout>0.0) {
+        event->wait(timeout);
+    } else {
+        event->wait();
+    }
+    Lock xx(mutex);
+    // pass the wakeup on to any other thread waiting for the same future
+    if(done) event->signal();
+    return done;
+}
+
+void PvaClientFuture::then(PvaClientFutureRequesterPtr const & requester)
+{
+    PvaClientCompletionQueuePtr queue;
+    {
+        Lock xx(mutex);
+        if(!done) {
+            requesters.push_back(requester);
+            return;
+        }
+        queue = this->queue.lock();
+    }
+    if(queue) {
+        queue->push(shared_from_this(),std::vector<PvaClientFutureRequesterPtr>(1,requester));
+        return;
+    }
+    requester->futureDone(shared_from_this());
+}
+
+void PvaClientFuture::bind(PvaClientCompletionQueuePtr const & queue)
+{
+    Lock xx(mutex);
+    this->queue = queue;
+}
+
+Status PvaClientFuture::getStatus()
+{
+    Lock xx(mutex);
+    return status;
+}
+
+PvaClientGetDataPtr PvaClientFuture::getGetData()
+{
+    Lock xx(mutex);
+    return getData;
+}
+
+PvaClientPutDataPtr PvaClientFuture::getPutData()
+{
+    Lock xx(mutex);
+    return putData;
+}
+
+PVStructurePtr PvaClientFuture::getPVStructure()
+{
+    Lock xx(mutex);
+    return pvStructure;
+}
+
+void PvaClientFuture::setOwner(std::tr1::shared_ptr<void> const & owner)
+{
+    Lock xx(mutex);
+    this->owner = owner;
+}
+
+void PvaClientFuture::complete(
+    Status const & status,
+    PvaClientGetDataPtr const & getData,
+    PvaClientPutDataPtr const & putData,
+    PVStructurePtr const & pvStructure)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientFuture::complete"
+           << " status.isOK " << (status.isOK() ? "true" : "false")
+           << endl;
+    }
+    std::vector<PvaClientFutureRequesterPtr> requesters;
+    std::tr1::shared_ptr<void> owner;
+    PvaClientCompletionQueuePtr queue;
+    {
+        Lock xx(mutex);
+        if(done) return;
+        done = true;
+        this->status = status;
+        this->getData = getData;
+        this->putData = putData;
+        this->pvStructure = pvStructure;
+        requesters.swap(this->requesters);
+        owner.swap(this->owner);
+        queue = this->queue.lock();
+        if(waitForDone) waitForDone->signal();
+    }
+    PvaClientFuturePtr future(shared_from_this());
+    if(queue) {
+        if(!requesters.empty()) queue->push(future,requesters);
+        return;
+    }
+    for(size_t i=0; i<requesters.size(); ++i) requesters[i]->futureDone(future);
+}
+
+}}
@@ -168,7 +168,8 @@ void PvaClientGet::channelGetConnect(
     }
     PvaClientGetRequesterPtr  req(pvaClientGetRequester.lock());
     if(req) {
-          req->channelGetConnect(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientGetRequester::channelGetConnect,
+              status,shared_from_this());
     }    
 }
 
@@ -184,6 +185,7 @@ void PvaClientGet::getDone(
            << " status.isOK " << (status.isOK() ? "true" : "false")
            << "\n";
     }
+    PvaClientFuturePtr future;
     {
         Lock xx(mutex);
         channelGetStatus = status;
@@ -191,12 +193,16 @@ void PvaClientGet::getDone(
             pvaClientData->setData(pvStructure,bitSet);
         }
         getState = getComplete;
-        waitForGet.signal();
+        // a get issued by getAsync is waited for with its future, not waitGet
+        future.swap(this->future);
+        if(!future && waitForGet) waitForGet->signal();
     }
     PvaClientGetRequesterPtr  req(pvaClientGetRequester.lock());
     if(req) {
-          req->getDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientGetRequester::getDone,
+              status,shared_from_this());
     }
+    if(future) future->complete(status,pvaClientData);
 }
 
 void PvaClientGet::connect()
@@ -266,7 +272,12 @@ void PvaClientGet::issueGet()
         throw std::runtime_error(message);
     }
     getState = getActive;
-    channelGet->get();
+    try {
+        channelGet->get();
+    } catch (...) {
+        getState = getIdle;
+        throw;
+    }
 }
 
 Status PvaClientGet::waitGet()
@@ -275,9 +286,45 @@ Status PvaClientGet::waitGet()
         cout << "PvaClientGet::waitGet channelName "
            << pvaClientChannel->getChannel()->getChannelName() << "\n";
     }
-    waitForGet.wait();
+    while(true) {
+        EventPtr event;
+        {
+            Lock xx(mutex);
+            if(getState!=getActive) break;
+            if(!waitForGet) waitForGet = EventPtr(new Event());
+            event = waitForGet;
+        }
+        event->wait();
+    }
     return channelGetStatus;
 }
+PvaClientFuturePtr PvaClientGet::getAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientGet::getAsync channelName "
+           << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    future->setOwner(shared_from_this());
+    {
+        Lock xx(mutex);
+        if(this->future) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientGet::getAsync get aleady active ";
+            throw std::runtime_error(message);
+        }
+        this->future = future;
+    }
+    try {
+        issueGet();
+    } catch (...) {
+        Lock xx(mutex);
+        this->future.reset();
+        throw;
+    }
+    return future;
+}
+
 PvaClientGetDataPtr PvaClientGet::getData()
 {
     if(PvaClient::getDebug()) {
@@ -0,0 +1,172 @@
+/* pvaClientGetPipeline.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <pv/lock.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClient.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+PvaClientGetPipelinePtr PvaClientGetPipeline::create(
+        PvaClientPtr const &pvaClient,
+        PvaClientChannelPtr const & pvaClientChannel,
+        PVStructurePtr const &pvRequest,
+        size_t depth)
+{
+    if(PvaClient::getDebug()) {
+         cout<< "PvaClientGetPipeline::create(pvaClient,channelName,pvRequest,depth)\n"
+             << " channelName " <<  pvaClientChannel->getChannel()->getChannelName()
+             << " pvRequest " << pvRequest
+             << " depth " << depth
+             << endl;
+    }
+    if(depth<1) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientGetPipeline::create depth must be at least 1";
+        throw std::runtime_error(message);
+    }
+    std::vector<PvaClientGetPtr> pvaClientGets(depth);
+    for(size_t i=0; i<depth; ++i) {
+        pvaClientGets[i] = PvaClientGet::create(pvaClient,pvaClientChannel,pvRequest);
+    }
+    PvaClientGetPipelinePtr pipeline(new PvaClientGetPipeline(pvaClientChannel,pvaClientGets));
+    return pipeline;
+}
+
+PvaClientGetPipeline::PvaClientGetPipeline(
+        PvaClientChannelPtr const & pvaClientChannel,
+        std::vector<PvaClientGetPtr> const & pvaClientGets)
+: pvaClientChannel(pvaClientChannel),
+  pvaClientGets(pvaClientGets),
+  depth(pvaClientGets.size()),
+  head(0),
+  outstanding(0)
+{
+     if(PvaClient::getDebug()) {
+        cout << "PvaClientGetPipeline::PvaClientGetPipeline channelName "
+             << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+}
+
+PvaClientGetPipeline::~PvaClientGetPipeline()
+{
+    if(PvaClient::getDebug()) {
+        cout<< "PvaClientGetPipeline::~PvaClientGetPipeline channelName "
+           << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+}
+
+void PvaClientGetPipeline::connect()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientGetPipeline::connect channelName "
+           << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+    for(size_t i=0; i<depth; ++i) pvaClientGets[i]->issueConnect();
+    for(size_t i=0; i<depth; ++i) {
+        Status status = pvaClientGets[i]->waitConnect();
+        if(status.isOK()) continue;
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+             + " PvaClientGetPipeline::connect " + status.getMessage();
+        throw std::runtime_error(message);
+    }
+}
+
+void PvaClientGetPipeline::issueGet()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientGetPipeline::issueGet channelName "
+           << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+    // gets are issued one at a time, so a failed issue only rolls back its own slot
+    Lock issue(issueMutex);
+    PvaClientGetPtr pvaClientGet;
+    {
+        Lock xx(mutex);
+        if(outstanding>=depth) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientGetPipeline::issueGet all gets are outstanding ";
+            throw std::runtime_error(message);
+        }
+        pvaClientGet = pvaClientGets[(head+outstanding)%depth];
+        ++outstanding;
+    }
+    // this includes PvaClientGet::issueGet failing to connect
+    try {
+        pvaClientGet->issueGet();
+    } catch (...) {
+        Lock xx(mutex);
+        --outstanding;
+        throw;
+    }
+}
+
+Status PvaClientGetPipeline::waitGet()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientGetPipeline::waitGet channelName "
+           << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+    PvaClientGetPtr pvaClientGet;
+    {
+        Lock xx(mutex);
+        if(outstanding==0) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientGetPipeline::waitGet no get is outstanding ";
+            throw std::runtime_error(message);
+        }
+        pvaClientGet = pvaClientGets[head];
+    }
+    Status status = pvaClientGet->waitGet();
+    Lock xx(mutex);
+    head = (head+1)%depth;
+    --outstanding;
+    if(status.isOK()) pvaClientData = pvaClientGet->getData();
+    return status;
+}
+
+PvaClientGetDataPtr PvaClientGetPipeline::getData()
+{
+    if(PvaClient::getDebug()) {
+           cout<< "PvaClientGetPipeline::getData  channelName "
+               << pvaClientChannel->getChannel()->getChannelName() << "\n";
+    }
+    Lock xx(mutex);
+    if(!pvaClientData) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientGetPipeline::getData no get has completed ";
+        throw std::runtime_error(message);
+    }
+    return pvaClientData;
+}
+
+size_t PvaClientGetPipeline::getDepth()
+{
+    return depth;
+}
+
+size_t PvaClientGetPipeline::getOutstanding()
+{
+    Lock xx(mutex);
+    return outstanding;
+}
+
+PvaClientChannelPtr PvaClientGetPipeline::getPvaClientChannel()
+{
+    return pvaClientChannel;
+}
+
+}}
@@ -10,6 +10,7 @@
  */
 
 #include <sstream>
+#include <epicsAtomic.h>
 #include <pv/event.h>
 #include <pv/bitSetUtil.h>
 
@@ -75,6 +76,179 @@ public:
     }
 };
 
+// Bounded ring of preallocated monitor elements.
+// Each slot has a sequence number as in the bounded queue of D. Vyukov:
+// slot.sequence==pos means free for the producer at pos,
+// slot.sequence==pos+1 means ready for the consumer at pos,
+// and busy means a thread owns the slot.
+// monitorEvent is the only producer. poll is the consumer.
+// The consumer owns the slot it returned until release or the next pop.
+class PvaClientMonitorQueue
+{
+public:
+    PvaClientMonitorQueue(
+        size_t capacity,
+        PvaClientMonitor::OverflowPolicy overflowPolicy,
+        StructureConstPtr const & structure);
+    ~PvaClientMonitorQueue();
+    void push(MonitorElementPtr const & element);
+    MonitorElementPtr pop();
+    void release();
+    PvaClientMonitorQueueStats getStats();
+private:
+    struct Slot
+    {
+        MonitorElementPtr element;
+        size_t sequence;
+    };
+    bool take(size_t pos,Slot & slot);
+    static const size_t busy;
+
+    std::vector<Slot> slots;
+    size_t capacity;
+    PvaClientMonitor::OverflowPolicy overflowPolicy;
+    size_t head;        // written by the producer
+    size_t tail;        // written by the thread that takes the oldest slot
+    size_t held;        // position of the slot owned by the consumer or busy
+    size_t maxQueued;
+    size_t pushed;
+    size_t popped;
+    size_t dropped;
+    size_t squashed;
+};
+
+const size_t PvaClientMonitorQueue::busy = ~static_cast<size_t>(0);
+
+PvaClientMonitorQueue::PvaClientMonitorQueue(
+    size_t capacity,
+    PvaClientMonitor::OverflowPolicy overflowPolicy,
+    StructureConstPtr const & structure)
+: slots(capacity+1),
+  capacity(capacity),
+  overflowPolicy(overflowPolicy),
+  head(0),
+  tail(0),
+  held(busy),
+  maxQueued(0),
+  pushed(0),
+  popped(0),
+  dropped(0),
+  squashed(0)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitorQueue::PvaClientMonitorQueue capacity " << capacity << endl;
+    }
+    // one more slot than capacity so the slot held by the consumer is not needed by the producer
+    for(size_t i=0; i<slots.size(); ++i) {
+        slots[i].element = MonitorElementPtr(
+            new MonitorElement(getPVDataCreate()->createPVStructure(structure)));
+        slots[i].sequence = i;
+    }
+}
+
+PvaClientMonitorQueue::~PvaClientMonitorQueue()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientMonitorQueue::~PvaClientMonitorQueue\n";
+}
+
+bool PvaClientMonitorQueue::take(size_t pos,Slot & slot)
+{
+    if(epicsAtomicCmpAndSwapSizeT(&slot.sequence,pos+1,busy)!=pos+1) return false;
+    // only the owner of the slot at tail advances tail
+    epicsAtomicSetSizeT(&tail,pos+1);
+    return true;
+}
+
+void PvaClientMonitorQueue::push(MonitorElementPtr const & element)
+{
+    size_t size = slots.size();
+    for(int attempt=0; attempt<3; ++attempt) {
+        Slot & slot = slots[head%size];
+        if(epicsAtomicGetSizeT(&slot.sequence)==head) {
+            MonitorElementPtr const & to = slot.element;
+            to->pvStructurePtr->copyUnchecked(*element->pvStructurePtr);
+            *to->changedBitSet = *element->changedBitSet;
+            *to->overrunBitSet = *element->overrunBitSet;
+            epicsAtomicSetSizeT(&slot.sequence,head+1);
+            epicsAtomicSetSizeT(&head,head+1);
+            epicsAtomicIncrSizeT(&pushed);
+            size_t queued = head - epicsAtomicGetSizeT(&tail);
+            if(queued>epicsAtomicGetSizeT(&maxQueued)) epicsAtomicSetSizeT(&maxQueued,queued);
+            return;
+        }
+        if(overflowPolicy==PvaClientMonitor::dropOldest) {
+            size_t pos = epicsAtomicGetSizeT(&tail);
+            // when only the slot held by the consumer blocks the producer there is nothing to drop
+            if(pos==head) break;
+            Slot & oldest = slots[pos%size];
+            if(take(pos,oldest)) {
+                epicsAtomicSetSizeT(&oldest.sequence,pos+size);
+                epicsAtomicIncrSizeT(&dropped);
+            }
+            continue;
+        }
+        if(overflowPolicy==PvaClientMonitor::squash && head>0) {
+            Slot & newest = slots[(head-1)%size];
+            if(epicsAtomicCmpAndSwapSizeT(&newest.sequence,head,busy)==head) {
+                MonitorElementPtr const & to = newest.element;
+                to->overrunBitSet->or_and(*to->changedBitSet,*element->changedBitSet);
+                *to->overrunBitSet |= *element->overrunBitSet;
+                *to->changedBitSet |= *element->changedBitSet;
+                to->pvStructurePtr->copyUnchecked(*element->pvStructurePtr);
+                epicsAtomicSetSizeT(&newest.sequence,head);
+                epicsAtomicIncrSizeT(&squashed);
+                return;
+            }
+            // the consumer took the newest update, so there may be room now
+            continue;
+        }
+        break;
+    }
+    epicsAtomicIncrSizeT(&dropped);
+}
+
+MonitorElementPtr PvaClientMonitorQueue::pop()
+{
+    release();
+    size_t size = slots.size();
+    while(true) {
+        size_t pos = epicsAtomicGetSizeT(&tail);
+        Slot & slot = slots[pos%size];
+        size_t sequence = epicsAtomicGetSizeT(&slot.sequence);
+        // busy means the producer is squashing into or dropping this slot.
+        // It is inside monitorEvent, which signals another event when it is done,
+        // so report the queue empty rather than wait for it.
+        if(sequence!=pos+1) return MonitorElementPtr();
+        if(!take(pos,slot)) continue;
+        epicsAtomicSetSizeT(&held,pos);
+        epicsAtomicIncrSizeT(&popped);
+        return slot.element;
+    }
+}
+
+void PvaClientMonitorQueue::release()
+{
+    size_t pos = epicsAtomicGetSizeT(&held);
+    if(pos==busy) return;
+    epicsAtomicSetSizeT(&held,busy);
+    epicsAtomicSetSizeT(&slots[pos%slots.size()].sequence,pos+slots.size());
+}
+
+PvaClientMonitorQueueStats PvaClientMonitorQueue::getStats()
+{
+    PvaClientMonitorQueueStats stats;
+    stats.capacity = capacity;
+    size_t pos = epicsAtomicGetSizeT(&tail);
+    size_t end = epicsAtomicGetSizeT(&head);
+    stats.queued = (end>pos) ? end - pos : 0;
+    stats.maxQueued = epicsAtomicGetSizeT(&maxQueued);
+    stats.pushed = epicsAtomicGetSizeT(&pushed);
+    stats.popped = epicsAtomicGetSizeT(&popped);
+    stats.dropped = epicsAtomicGetSizeT(&dropped);
+    stats.squashed = epicsAtomicGetSizeT(&squashed);
+    return stats;
+}
+
 
 PvaClientMonitorPtr PvaClientMonitor::create(
         PvaClientPtr const &pvaClient,
@@ -102,9 +276,7 @@ PvaClientMonitorPtr PvaClientMonitor::create(
              << " request " << request
              << endl;
     }
-    CreateRequest::shared_pointer createRequest(CreateRequest::create());
-    PVStructurePtr pvRequest(createRequest->createRequest(request));
-    if(!pvRequest) throw std::runtime_error(createRequest->getMessage());
+    PVStructurePtr pvRequest(pvaClient->createRequest(request));
     PvaClientChannelPtr pvaClientChannel = pvaClient->createChannel(channelName,providerName);
     PvaClientMonitorPtr clientMonitor(new PvaClientMonitor(pvaClient,pvaClientChannel,pvRequest));
     clientMonitor->monitorRequester = MonitorRequesterImplPtr(
@@ -127,7 +299,11 @@ PvaClientMonitor::PvaClientMonitor(
   isStarted(false),
   connectState(connectIdle),
   userPoll(false),
-  userWait(false)
+  userWait(0),
+  eventPending(0),
+  queueCapacity(0),
+  overflowPolicy(dropOldest),
+  selectorReady(false)
 {
     if(PvaClient::getDebug()) {
          cout<< "PvaClientMonitor::PvaClientMonitor\n"
@@ -146,6 +322,8 @@ PvaClientMonitor::~PvaClientMonitor()
     if(monitor) {
        if(isStarted) monitor->stop();
     }
+    PvaClientMonitorSelectorPtr selector(this->selector.lock());
+    if(selector) selector->removeDestroyed();
 }
 
 void PvaClientMonitor::channelStateChange(PvaClientChannelPtr const & channel, bool isConnected)
@@ -225,6 +403,10 @@ void PvaClientMonitor::monitorConnect(
         monitorConnectStatus = status;
         if(status.isOK()) {
             this->monitor = monitor;
+            if(queueCapacity>0) {
+                queue = PvaClientMonitorQueuePtr(
+                    new PvaClientMonitorQueue(queueCapacity,overflowPolicy,structure));
+            }
         } else {
              stringstream ss;
              ss << pvRequest;
@@ -235,7 +417,10 @@ void PvaClientMonitor::monitorConnect(
              monitorConnectStatus = Status(Status::STATUSTYPE_ERROR,message);
              waitForConnect.signal();
              PvaClientMonitorRequesterPtr req(pvaClientMonitorRequester.lock());
-             if(req) req->monitorConnect(status,shared_from_this(),structure);
+             if(req) {
+                 PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientMonitorRequester::monitorConnect,
+                     status,shared_from_this(),structure);
+             }
              return;
         }
     }
@@ -250,7 +435,10 @@ void PvaClientMonitor::monitorConnect(
         }
         waitForConnect.signal();
         PvaClientMonitorRequesterPtr req(pvaClientMonitorRequester.lock());
-        if(req) req->monitorConnect(status,shared_from_this(),structure);
+        if(req) {
+            PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientMonitorRequester::monitorConnect,
+                status,shared_from_this(),structure);
+        }
         return;
     }
     pvaClientData = PvaClientMonitorData::create(structure);
@@ -271,7 +459,10 @@ void PvaClientMonitor::monitorConnect(
         start();
     }
     PvaClientMonitorRequesterPtr req(pvaClientMonitorRequester.lock());
-    if(req) req->monitorConnect(status,shared_from_this(),structure);
+    if(req) {
+        PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientMonitorRequester::monitorConnect,
+            status,shared_from_this(),structure);
+    }
 }
 
 void PvaClientMonitor::monitorEvent(MonitorPtr const & monitor)
@@ -281,9 +472,30 @@ void PvaClientMonitor::monitorEvent(MonitorPtr const & monitor)
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
+    if(queue) {
+        // copy every element into the queue and give it back to pvAccess at once
+        MonitorElementPtr element;
+        while((element = monitor->poll())) {
+            queue->push(element);
+            monitor->release(element);
+        }
+    }
     PvaClientMonitorRequesterPtr req = pvaClientMonitorRequester.lock();
-    if(req) req->event(shared_from_this());
-    if(userWait) waitForEvent.signal();
+    if(req) {
+        PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientMonitorRequester::event,shared_from_this());
+    }
+    if(epicsAtomicGetIntT(&userWait)) waitForEvent.signal();
+    PvaClientFuturePtr future;
+    PvaClientMonitorSelectorPtr selector;
+    {
+        // the future only says that data is ready; the thread that waits for it polls
+        Lock xx(mutex);
+        epicsAtomicSetIntT(&eventPending,1);
+        future.swap(this->future);
+        selector = this->selector.lock();
+    }
+    if(future) future->complete(Status::Ok);
+    if(selector) selector->notify(shared_from_this());
 }
 
 void PvaClientMonitor::unlisten(MonitorPtr const & monitor)
@@ -291,8 +503,14 @@ void PvaClientMonitor::unlisten(MonitorPtr const & monitor)
     if(PvaClient::getDebug()) cout << "PvaClientMonitor::unlisten\n";
     PvaClientMonitorRequesterPtr req = pvaClientMonitorRequester.lock();
     if(req) {
-        req->unlisten();
+        PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientMonitorRequester::unlisten);
     }
+    PvaClientFuturePtr future;
+    {
+        Lock xx(mutex);
+        future.swap(this->future);
+    }
+    if(future) future->complete(Status(Status::STATUSTYPE_ERROR,"monitor unlisten"));
 }
 
 
@@ -384,9 +602,7 @@ void PvaClientMonitor::start(string const & request)
              errorMessage);
         return;
     }
-    CreateRequest::shared_pointer createRequest(CreateRequest::create());
-    PVStructurePtr pvr(createRequest->createRequest(request));
-    if(!pvr) throw std::runtime_error(createRequest->getMessage());
+    PVStructurePtr pvr(client->createRequest(request));
     if(monitor) {
        if(isStarted) monitor->stop();
     }
@@ -410,6 +626,8 @@ void PvaClientMonitor::stop()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
+    PvaClientMonitorSelectorPtr selector(this->selector.lock());
+    if(selector) selector->remove(shared_from_this());
     if(!isStarted) return;
     isStarted = false;
     monitor->stop();
@@ -423,8 +641,11 @@ bool PvaClientMonitor::poll()
            << endl;
     }
     checkMonitorState();
-    monitorElement = monitor->poll();
+    // cleared before polling, so an event that arrives after an empty poll sets it again
+    epicsAtomicSetIntT(&eventPending,0);
+    monitorElement = queue ? queue->pop() : monitor->poll();
     if(!monitorElement) return false;
+    epicsAtomicSetIntT(&eventPending,1);
     userPoll = true;
     pvaClientData->setData(monitorElement);
     return true;
@@ -443,14 +664,53 @@ bool PvaClientMonitor::waitEvent(double secondsToWait)
         throw std::runtime_error(message);
     }
     if(poll()) return true;
-    userWait = true;
-    if(secondsToWait==0.0) {
-        waitForEvent.wait();
-    } else {
-        waitForEvent.wait(secondsToWait);
+    // discard a signal left from an earlier wait, then announce the wait
+    // before polling again so that an event arriving in between is not missed
+    waitForEvent.tryWait();
+    epicsAtomicSetIntT(&userWait,1);
+    bool result = poll();
+    if(!result) {
+        if(secondsToWait==0.0) {
+            waitForEvent.wait();
+        } else {
+            waitForEvent.wait(secondsToWait);
+        }
+        result = poll();
     }
-    userWait = false;
-    return poll();
+    epicsAtomicSetIntT(&userWait,0);
+    return result;
+}
+
+PvaClientFuturePtr PvaClientMonitor::eventAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitor::eventAsync"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << endl;
+    }
+    if(!isStarted) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientMonitor::eventAsync illegal state ";
+        throw std::runtime_error(message);
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    bool ready = false;
+    {
+        // monitorEvent sets eventPending under the same lock so an event cannot be missed
+        Lock xx(mutex);
+        if(this->future) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientMonitor::eventAsync aleady waiting for event ";
+            throw std::runtime_error(message);
+        }
+        ready = epicsAtomicGetIntT(&eventPending) ? true : false;
+        if(!ready) {
+            future->setOwner(shared_from_this());
+            this->future = future;
+        }
+    }
+    if(ready) future->complete(Status::Ok);
+    return future;
 }
 
 void PvaClientMonitor::releaseEvent()
@@ -466,9 +726,99 @@ void PvaClientMonitor::releaseEvent()
         throw std::runtime_error(message);
     }
     userPoll = false;
+    if(queue) {
+        queue->release();
+        return;
+    }
     monitor->release(monitorElement);
 }
 
+size_t PvaClientMonitor::pollBatch(size_t maxElements,PvaClientMonitorVisitor & visitor)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitor::pollBatch"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << " maxElements " << maxElements
+           << endl;
+    }
+    checkMonitorState();
+    if(userPoll) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientMonitor::pollBatch releaseEvent was not called";
+        throw std::runtime_error(message);
+    }
+    size_t count = 0;
+    epicsAtomicSetIntT(&eventPending,0);
+    if(queue) {
+        // each pop gives back the previous slot, so only the last needs a release
+        try {
+            while(maxElements==0 || count<maxElements) {
+                MonitorElementPtr element(queue->pop());
+                if(!element) break;
+                visitor.visit(element->pvStructurePtr,element->changedBitSet,element->overrunBitSet);
+                ++count;
+            }
+        } catch (...) {
+            queue->release();
+            throw;
+        }
+        queue->release();
+        if(maxElements>0 && count==maxElements) epicsAtomicSetIntT(&eventPending,1);
+        return count;
+    }
+    try {
+        while(maxElements==0 || count<maxElements) {
+            MonitorElementPtr element(monitor->poll());
+            if(!element) break;
+            batchElements.push_back(element);
+            visitor.visit(element->pvStructurePtr,element->changedBitSet,element->overrunBitSet);
+            ++count;
+        }
+    } catch (...) {
+        for(size_t i=0; i<batchElements.size(); ++i) monitor->release(batchElements[i]);
+        batchElements.clear();
+        throw;
+    }
+    for(size_t i=0; i<batchElements.size(); ++i) monitor->release(batchElements[i]);
+    batchElements.clear();
+    if(maxElements>0 && count==maxElements) epicsAtomicSetIntT(&eventPending,1);
+    return count;
+}
+
+void PvaClientMonitor::setQueue(size_t capacity,OverflowPolicy overflowPolicy)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitor::setQueue"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << " capacity " << capacity
+           << " overflowPolicy " << overflowPolicy
+           << endl;
+    }
+    if(connectState!=connectIdle) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientMonitor::setQueue must be called before connect";
+        throw std::runtime_error(message);
+    }
+    if(capacity<1) {
+        string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+            + " PvaClientMonitor::setQueue capacity must be at least 1";
+        throw std::runtime_error(message);
+    }
+    queueCapacity = capacity;
+    this->overflowPolicy = overflowPolicy;
+}
+
+PvaClientMonitorQueueStats PvaClientMonitor::getQueueStats()
+{
+    PvaClientMonitorQueuePtr queue;
+    {
+        Lock xx(mutex);
+        queue = this->queue;
+    }
+    if(!queue) return PvaClientMonitorQueueStats();
+    return queue->getStats();
+}
+
 PvaClientChannelPtr PvaClientMonitor::getPvaClientChannel()
 {
     return pvaClientChannel;
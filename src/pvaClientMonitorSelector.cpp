@@ -0,0 +1,156 @@
+/* pvaClientMonitorSelector.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <pv/event.h>
+#include <pv/lock.h>
+#include <pv/timeStamp.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClient.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+PvaClientMonitorSelectorPtr PvaClientMonitorSelector::create()
+{
+    PvaClientMonitorSelectorPtr selector(new PvaClientMonitorSelector());
+    return selector;
+}
+
+PvaClientMonitorSelector::PvaClientMonitorSelector()
+: numberMonitors(0)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientMonitorSelector::PvaClientMonitorSelector\n";
+}
+
+PvaClientMonitorSelector::~PvaClientMonitorSelector()
+{
+    if(PvaClient::getDebug()) cout << "PvaClientMonitorSelector::~PvaClientMonitorSelector\n";
+}
+
+void PvaClientMonitorSelector::add(PvaClientMonitorPtr const & pvaClientMonitor)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitorSelector::add channelName "
+             << pvaClientMonitor->getPvaClientChannel()->getChannelName() << endl;
+    }
+    {
+        Lock xx(pvaClientMonitor->mutex);
+        if(pvaClientMonitor->selector.lock()) {
+            string message = string("channel ")
+                + pvaClientMonitor->getPvaClientChannel()->getChannelName()
+                + " PvaClientMonitorSelector::add monitor is already registered";
+            throw std::runtime_error(message);
+        }
+        pvaClientMonitor->selector = shared_from_this();
+    }
+    {
+        Lock xx(mutex);
+        ++numberMonitors;
+    }
+    notify(pvaClientMonitor);
+}
+
+void PvaClientMonitorSelector::remove(PvaClientMonitorPtr const & pvaClientMonitor)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitorSelector::remove channelName "
+             << pvaClientMonitor->getPvaClientChannel()->getChannelName() << endl;
+    }
+    {
+        Lock xx(pvaClientMonitor->mutex);
+        if(pvaClientMonitor->selector.lock().get()!=this) return;
+        pvaClientMonitor->selector.reset();
+    }
+    Lock xx(mutex);
+    --numberMonitors;
+    if(!pvaClientMonitor->selectorReady) return;
+    pvaClientMonitor->selectorReady = false;
+    for(size_t i=0; i<readyList.size(); ++i) {
+        if(readyList[i]!=pvaClientMonitor) continue;
+        readyList.erase(readyList.begin()+i);
+        break;
+    }
+}
+
+bool PvaClientMonitorSelector::contains(PvaClientMonitorPtr const & pvaClientMonitor)
+{
+    Lock xx(pvaClientMonitor->mutex);
+    return pvaClientMonitor->selector.lock().get()==this;
+}
+
+// a monitor being destroyed cannot be in readyList, which holds a reference to it
+void PvaClientMonitorSelector::removeDestroyed()
+{
+    Lock xx(mutex);
+    --numberMonitors;
+}
+
+void PvaClientMonitorSelector::notify(PvaClientMonitorPtr const & pvaClientMonitor)
+{
+    Lock xx(mutex);
+    if(pvaClientMonitor->selectorReady) return;
+    pvaClientMonitor->selectorReady = true;
+    readyList.push_back(pvaClientMonitor);
+    if(readyList.size()==1) waitForReady.signal();
+}
+
+size_t PvaClientMonitorSelector::wait(
+    std::vector<PvaClientMonitorPtr> & ready,
+    double secondsToWait)
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientMonitorSelector::wait secondsToWait " << secondsToWait << endl;
+    }
+    ready.clear();
+    TimeStamp startTime;
+    startTime.getCurrent();
+    Lock xx(mutex);
+    while(readyList.empty()) {
+        xx.unlock();
+        if(secondsToWait==0.0) {
+            waitForReady.wait();
+        } else {
+            TimeStamp now;
+            now.getCurrent();
+            double remaining = secondsToWait - TimeStamp::diff(now,startTime);
+            if(remaining<=0.0) {
+                xx.lock();
+                break;
+            }
+            waitForReady.wait(remaining);
+        }
+        xx.lock();
+    }
+    ready.swap(readyList);
+    for(size_t i=0; i<ready.size(); ++i) ready[i]->selectorReady = false;
+    return ready.size();
+}
+
+size_t PvaClientMonitorSelector::poll(std::vector<PvaClientMonitorPtr> & ready)
+{
+    ready.clear();
+    Lock xx(mutex);
+    ready.swap(readyList);
+    for(size_t i=0; i<ready.size(); ++i) ready[i]->selectorReady = false;
+    return ready.size();
+}
+
+size_t PvaClientMonitorSelector::getNumberMonitors()
+{
+    Lock xx(mutex);
+    return numberMonitors;
+}
+
+}}
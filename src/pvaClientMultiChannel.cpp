@@ -10,6 +10,7 @@
  */
 
 #include <map>
+#include <algorithm>
 #include <pv/event.h>
 #include <pv/lock.h>
 
@@ -24,7 +25,27 @@ using namespace std;
 namespace epics { namespace pvaClient {
 
 static FieldCreatePtr fieldCreate = getFieldCreate();
-static CreateRequest::shared_pointer  createRequestPvt = CreateRequest::create();
+
+class PvaClientMultiChannelStateChange :
+    public PvaClientChannelStateChangeRequester
+{
+public:
+    PvaClientMultiChannelStateChange(
+        PvaClientMultiChannelPtr const & pvaClientMultiChannel,
+        size_t index)
+    : pvaClientMultiChannel(pvaClientMultiChannel),
+      index(index)
+    {}
+    virtual ~PvaClientMultiChannelStateChange() {}
+    virtual void channelStateChange(PvaClientChannelPtr const & channel, bool isConnected)
+    {
+        PvaClientMultiChannelPtr multiChannel(pvaClientMultiChannel.lock());
+        if(multiChannel) multiChannel->setConnected(index,isConnected);
+    }
+private:
+    PvaClientMultiChannelWPtr pvaClientMultiChannel;
+    size_t index;
+};
 
 PvaClientMultiChannelPtr PvaClientMultiChannel::create(
    PvaClientPtr const &pvaClient,
@@ -55,8 +76,11 @@ PvaClientMultiChannel::PvaClientMultiChannel(
   numConnected(0),
   firstConnect(true),
   pvaClientChannelArray(PvaClientChannelArray(numChannel,PvaClientChannelPtr())),
-  isConnected(shared_vector<epics::pvData::boolean>(numChannel,false)),
-  createRequest(CreateRequest::create())
+  isConnected(numChannel,false),
+  isReported(numChannel,false),
+  connectionVersion(0),
+  lastVersion(0),
+  copyVersion(0)
 {
     if(PvaClient::getDebug()) cout<< "PvaClientMultiChannel::PvaClientMultiChannel()\n";
 }
@@ -83,65 +107,115 @@ Status PvaClientMultiChannel::connect(double timeout)
 {
     if(!firstConnect) return Status::Ok;
     firstConnect = false;
+    // one latch for all channels so the wait is bounded by a single deadline
+    PvaClientConnectLatchPtr latch(PvaClientConnectLatch::create(numChannel));
+    std::vector<Status> status(numChannel,Status::Ok);
     for(size_t i=0; i< numChannel; ++i) {
         if(numProviderNames<=i) {
             pvaClientChannelArray[i] = pvaClient->createChannel(channelNames[i],providerName);
         } else {
             pvaClientChannelArray[i] = pvaClient->createChannel(channelNames[i],providerNames[i]);
-        }    
-        pvaClientChannelArray[i]->issueConnect();
+        }
+        stateChangeRequester.push_back(PvaClientMultiChannelStateChangePtr(
+            new PvaClientMultiChannelStateChange(shared_from_this(),i)));
+        // a listener, so a requester set by the user does not take the slot
+        pvaClientChannelArray[i]->addStateChangeListener(stateChangeRequester[i]);
+        pvaClientChannelArray[i]->setConnectLatch(latch);
+        try {
+            pvaClientChannelArray[i]->issueConnect();
+        } catch (std::exception& e) {
+            status[i] = Status(Status::STATUSTYPE_ERROR,e.what());
+            pvaClientChannelArray[i]->releaseConnectLatch();
+        }
     }
+    latch->wait(timeout);
     Status returnStatus = Status::Ok;
-    Status status = Status::Ok;
     size_t numBad = 0;
     for(size_t i=0; i< numChannel; ++i) {
-        if(numBad==0) {
-            status = pvaClientChannelArray[i]->waitConnect(timeout);
-        } else {
-            status = pvaClientChannelArray[i]->waitConnect(.001);
+        pvaClientChannelArray[i]->releaseConnectLatch();
+        if(status[i].isOK() && !pvaClientChannelArray[i]->isChannelConnected()) {
+            status[i] = Status(Status::STATUSTYPE_ERROR,
+                string("channel ") + channelNames[i] + " PvaClientMultiChannel::connect not connected");
         }
-        if(status.isOK()) {
-            ++numConnected;
-            isConnected[i] = true;
-        } else {
-            if(returnStatus.isOK()) returnStatus = status;
+        // the state change callback may not have run yet
+        initConnected(i,status[i].isOK());
+        if(!status[i].isOK()) {
+            if(returnStatus.isOK()) returnStatus = status[i];
             ++numBad;
         }
     }
+    {
+        Lock xx(mutex);
+        connectStatus.swap(status);
+    }
     return numBad>maxNotConnected ? returnStatus : Status::Ok;
 }
 
+std::vector<Status> PvaClientMultiChannel::getConnectStatus()
+{
+    Lock xx(mutex);
+    return connectStatus;
+}
+
 
 bool PvaClientMultiChannel::allConnected()
 {
+    Lock xx(mutex);
     return (numConnected==numChannel) ? true : false;
 }
 
 bool PvaClientMultiChannel::connectionChange()
 {
-    for(size_t i=0; i<numChannel; ++i) {
-         PvaClientChannelPtr pvaClientChannel = pvaClientChannelArray[i];
-         Channel::shared_pointer channel = pvaClientChannel->getChannel();
-         Channel::ConnectionState stateNow = channel->getConnectionState();
-         bool connectedNow = stateNow==Channel::CONNECTED ? true : false;
-         if(connectedNow!=isConnected[i]) return true;
-    }
-    return false;
+    Lock xx(mutex);
+    return connectionVersion!=lastVersion;
 }
 
 shared_vector<epics::pvData::boolean>  PvaClientMultiChannel::getIsConnected()
 {
-    for(size_t i=0; i<numChannel; ++i) {
-         PvaClientChannelPtr pvaClientChannel = pvaClientChannelArray[i];
-         if(!pvaClientChannel) {
-              isConnected[i] = false;
-              continue;
-         }
-         Channel::shared_pointer channel = pvaClientChannel->getChannel();
-         Channel::ConnectionState stateNow = channel->getConnectionState();
-         isConnected[i] = (stateNow==Channel::CONNECTED) ? true : false;
+    Lock xx(mutex);
+    lastVersion = connectionVersion;
+    // copied only when a caller asks after a change, not on every change
+    if(isConnectedCopy.size()!=numChannel || copyVersion!=connectionVersion) {
+        shared_vector<epics::pvData::boolean> copy(numChannel);
+        std::copy(isConnected.begin(),isConnected.end(),copy.begin());
+        isConnectedCopy = copy;
+        copyVersion = connectionVersion;
     }
-    return isConnected;
+    return isConnectedCopy;
+}
+
+size_t PvaClientMultiChannel::getConnectionVersion()
+{
+    Lock xx(mutex);
+    return connectionVersion;
+}
+
+void PvaClientMultiChannel::setConnected(size_t index,bool connected)
+{
+    Lock xx(mutex);
+    isReported[index] = true;
+    changeConnected(index,connected);
+}
+
+void PvaClientMultiChannel::initConnected(size_t index,bool connected)
+{
+    Lock xx(mutex);
+    // the state change callback reported a state that may be newer
+    if(isReported[index]) return;
+    changeConnected(index,connected);
+}
+
+// caller must hold mutex
+void PvaClientMultiChannel::changeConnected(size_t index,bool connected)
+{
+    if((isConnected[index] ? true : false)==connected) return;
+    isConnected[index] = connected;
+    if(connected) {
+        ++numConnected;
+    } else {
+        --numConnected;
+    }
+    ++connectionVersion;
 }
 
 PvaClientChannelArray PvaClientMultiChannel::getPvaClientChannelArray()
@@ -186,10 +260,11 @@ PvaClientNTMultiPutPtr PvaClientMultiChannel::createNTPut()
 PvaClientNTMultiGetPtr PvaClientMultiChannel::createNTGet(std::string const &request)
 {
     checkConnected();
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = " PvaClientMultiChannel::createNTGet invalid pvRequest: "
-             + createRequest->getMessage();
+    PVStructurePtr pvRequest;
+    try {
+        pvRequest = pvaClient->createRequest(request);
+    } catch (std::exception& e) {
+        string message = string(" PvaClientMultiChannel::createNTGet ") + e.what();
         throw std::runtime_error(message);
     }
     return PvaClientNTMultiGet::create(shared_from_this(), pvaClientChannelArray,pvRequest);
@@ -198,14 +273,28 @@ PvaClientNTMultiGetPtr PvaClientMultiChannel::createNTGet(std::string const &req
 PvaClientNTMultiMonitorPtr PvaClientMultiChannel::createNTMonitor(std::string const &request)
 {
     checkConnected();
-    PVStructurePtr pvRequest = createRequest->createRequest(request);
-    if(!pvRequest) {
-        string message = " PvaClientMultiChannel::createNTMonitor invalid pvRequest: "
-             + createRequest->getMessage();
+    PVStructurePtr pvRequest;
+    try {
+        pvRequest = pvaClient->createRequest(request);
+    } catch (std::exception& e) {
+        string message = string(" PvaClientMultiChannel::createNTMonitor ") + e.what();
         throw std::runtime_error(message);
     }
     return PvaClientNTMultiMonitor::create(shared_from_this(), pvaClientChannelArray,pvRequest);
 }
 
+PvaClientMultiFrameBuilderPtr PvaClientMultiChannel::createFrameBuilder(std::string const &request)
+{
+    checkConnected();
+    PVStructurePtr pvRequest;
+    try {
+        pvRequest = pvaClient->createRequest(request);
+    } catch (std::exception& e) {
+        string message = string(" PvaClientMultiChannel::createFrameBuilder ") + e.what();
+        throw std::runtime_error(message);
+    }
+    return PvaClientMultiFrameBuilder::create(shared_from_this(), pvaClientChannelArray,pvRequest);
+}
+
 
 }}
@@ -0,0 +1,298 @@
+/* pvaClientMultiFrame.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <pv/timeStamp.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClientMultiChannel.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::nt;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+PvaClientMultiFrame::PvaClientMultiFrame(size_t nchannel)
+: numberPresent(0),
+  isPresent(shared_vector<epics::pvData::boolean>(nchannel,false)),
+  pvStructure(nchannel),
+  secondsPastEpoch(0),
+  nanoseconds(0),
+  userTag(0)
+{
+}
+
+PvaClientMultiFrame::~PvaClientMultiFrame()
+{
+}
+
+size_t PvaClientMultiFrame::getNumber()
+{
+    return pvStructure.size();
+}
+
+size_t PvaClientMultiFrame::getNumberPresent()
+{
+    return numberPresent;
+}
+
+shared_vector<epics::pvData::boolean> PvaClientMultiFrame::getIsPresent()
+{
+    return isPresent;
+}
+
+PVStructurePtr PvaClientMultiFrame::getPVStructure(size_t index)
+{
+    if(index>=pvStructure.size()) {
+        throw std::runtime_error("PvaClientMultiFrame::getPVStructure index out of range");
+    }
+    return pvStructure[index];
+}
+
+int64 PvaClientMultiFrame::getSecondsPastEpoch()
+{
+    return secondsPastEpoch;
+}
+
+int32 PvaClientMultiFrame::getNanoseconds()
+{
+    return nanoseconds;
+}
+
+int32 PvaClientMultiFrame::getUserTag()
+{
+    return userTag;
+}
+
+PvaClientMultiFrameBuilderPtr PvaClientMultiFrameBuilder::create(
+    PvaClientMultiChannelPtr const &pvaMultiChannel,
+    PvaClientChannelArray const &pvaClientChannelArray,
+    PVStructurePtr const &  pvRequest)
+{
+    if(!pvRequest->getSubField("field.timeStamp")) {
+        // a frame reports the whole timeStamp, whatever the key
+        throw std::runtime_error("PvaClientMultiFrameBuilder::create pvRequest does not select timeStamp");
+    }
+    return PvaClientMultiFrameBuilderPtr(
+        new PvaClientMultiFrameBuilder(pvaMultiChannel,pvaClientChannelArray,pvRequest));
+}
+
+PvaClientMultiFrameBuilder::PvaClientMultiFrameBuilder(
+     PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+     PvaClientChannelArray const &pvaClientChannelArray,
+     PVStructurePtr const &  pvRequest)
+: pvaClientMultiChannel(pvaClientMultiChannel),
+  pvaClientChannelArray(pvaClientChannelArray),
+  pvRequest(pvRequest),
+  nchannel(pvaClientChannelArray.size()),
+  keyType(timeStampKey),
+  quorum(0),
+  maxFrames(100),
+  maxAge(1.0),
+  monitorSet(PvaClientMultiMonitorSet::create(
+      pvaClientMultiChannel,
+      pvaClientChannelArray,
+      pvRequest)),
+  timeStampFields(nchannel)
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiFrameBuilder::PvaClientMultiFrameBuilder()\n";
+}
+
+PvaClientMultiFrameBuilder::~PvaClientMultiFrameBuilder()
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiFrameBuilder::~PvaClientMultiFrameBuilder()\n";
+}
+
+void PvaClientMultiFrameBuilder::setKeyType(KeyType keyType)
+{
+    this->keyType = keyType;
+}
+
+void PvaClientMultiFrameBuilder::setQuorum(size_t quorum)
+{
+    this->quorum = quorum;
+}
+
+void PvaClientMultiFrameBuilder::setLimits(size_t maxFrames,double maxAge)
+{
+    this->maxFrames = (maxFrames<1) ? 1 : maxFrames;
+    this->maxAge = maxAge;
+}
+
+void PvaClientMultiFrameBuilder::connect()
+{
+    monitorSet->check();
+}
+
+void PvaClientMultiFrameBuilder::done(FrameKey const & key,PvaClientMultiFramePtr const & frame)
+{
+    // remember recent keys so that a late update does not start a frame that can never complete
+    doneKeys.insert(key);
+    doneOrder.push_back(key);
+    while(doneOrder.size()>maxFrames) {
+        doneKeys.erase(doneOrder.front());
+        doneOrder.pop_front();
+    }
+    if(!frame) return;
+    if(ready.size()>=maxFrames) {
+        ready.pop_front();
+        ++stats.dropped;
+    }
+    ready.push_back(frame);
+}
+
+void PvaClientMultiFrameBuilder::ageOut(FrameMap::iterator iter)
+{
+    FrameKey key = iter->first;
+    PvaClientMultiFramePtr frame = iter->second;
+    pending.erase(iter);
+    size_t required = (quorum==0 || quorum>nchannel) ? nchannel : quorum;
+    if(frame->numberPresent>=required) {
+        ++stats.partial;
+        done(key,frame);
+    } else {
+        ++stats.incomplete;
+        done(key,PvaClientMultiFramePtr());
+    }
+}
+
+PvaClientMultiFrameBuilder::FrameMap::iterator PvaClientMultiFrameBuilder::oldestPending()
+{
+    // with userTag keys the smallest key is not the oldest frame
+    FrameMap::iterator oldest = pending.begin();
+    FrameMap::iterator iter;
+    for(iter = pending.begin(); iter != pending.end(); ++iter) {
+        if(TimeStamp::diff(iter->second->firstUpdate,oldest->second->firstUpdate)<0.0) {
+            oldest = iter;
+        }
+    }
+    return oldest;
+}
+
+void PvaClientMultiFrameBuilder::addUpdate(size_t index,PVStructurePtr const & pvStructure)
+{
+    TimeStampFields & fields = timeStampFields[index];
+    PVLongPtr pvSeconds = fields.secondsPastEpoch.get(pvStructure);
+    PVIntPtr pvNano = fields.nanoseconds.get(pvStructure);
+    PVIntPtr pvTag = fields.userTag.get(pvStructure);
+    if(!pvSeconds || !pvNano || !pvTag) {
+        ++stats.ignored;
+        return;
+    }
+    FrameKey key = (keyType==timeStampKey)
+        ? FrameKey(pvSeconds->get(),pvNano->get())
+        : FrameKey(0,pvTag->get());
+    if(doneKeys.find(key)!=doneKeys.end()) {
+        ++stats.ignored;
+        return;
+    }
+    FrameMap::iterator iter = pending.find(key);
+    if(iter==pending.end()) {
+        if(pending.size()>=maxFrames) ageOut(oldestPending());
+        PvaClientMultiFramePtr frame(new PvaClientMultiFrame(nchannel));
+        frame->secondsPastEpoch = pvSeconds->get();
+        frame->nanoseconds = pvNano->get();
+        frame->userTag = pvTag->get();
+        frame->firstUpdate.getCurrent();
+        iter = pending.insert(FrameMap::value_type(key,frame)).first;
+    }
+    PvaClientMultiFrame & frame = *iter->second;
+    // the monitor reuses its data, so the frame keeps a copy
+    PVStructurePtr & pvCopy = frame.pvStructure[index];
+    if(!pvCopy) {
+        ++frame.numberPresent;
+        frame.isPresent[index] = true;
+    }
+    if(!pvCopy || pvCopy->getStructure()!=pvStructure->getStructure()) {
+        pvCopy = getPVDataCreate()->createPVStructure(pvStructure->getStructure());
+    }
+    pvCopy->copyUnchecked(*pvStructure);
+    if(frame.numberPresent==nchannel) {
+        PvaClientMultiFramePtr complete(iter->second);
+        pending.erase(iter);
+        ++stats.complete;
+        done(key,complete);
+    }
+}
+
+bool PvaClientMultiFrameBuilder::pollReady()
+{
+    for(size_t j=0; j<readyChannels.size(); ++j)
+    {
+         size_t i = readyChannels[j];
+         PvaClientMonitorPtr monitor(monitorSet->getMonitor(i));
+         while(monitor->poll()) {
+              addUpdate(i,monitor->getData()->getPVStructure());
+              monitor->releaseEvent();
+         }
+    }
+    readyChannels.clear();
+    if(!pending.empty()) {
+        TimeStamp now;
+        now.getCurrent();
+        FrameMap::iterator iter = pending.begin();
+        while(iter!=pending.end()) {
+            FrameMap::iterator next = iter;
+            ++next;
+            if(TimeStamp::diff(now,iter->second->firstUpdate)>=maxAge) ageOut(iter);
+            iter = next;
+        }
+    }
+    return !ready.empty();
+}
+
+bool PvaClientMultiFrameBuilder::poll()
+{
+    monitorSet->check();
+    monitorSet->poll(readyChannels);
+    return pollReady();
+}
+
+bool PvaClientMultiFrameBuilder::waitFrame(double secondsToWait)
+{
+    if(poll()) return true;
+    TimeStamp start;
+    start.getCurrent();
+    TimeStamp now;
+    while(true) {
+          now.getCurrent();
+          double remaining = secondsToWait - TimeStamp::diff(now,start);
+          if(remaining<=0.0) break;
+          // wake up in time to age out the oldest incomplete frame
+          double timeout = remaining;
+          if(!pending.empty()) {
+              double expires = maxAge - TimeStamp::diff(now,oldestPending()->second->firstUpdate);
+              if(expires<0.0) expires = 0.0;
+              if(expires<timeout) timeout = expires;
+          }
+          monitorSet->wait(readyChannels,timeout);
+          if(pollReady()) return true;
+    }
+    return false;
+}
+
+PvaClientMultiFramePtr PvaClientMultiFrameBuilder::getFrame()
+{
+    if(ready.empty()) return PvaClientMultiFramePtr();
+    PvaClientMultiFramePtr frame(ready.front());
+    ready.pop_front();
+    return frame;
+}
+
+PvaClientMultiFrameStats PvaClientMultiFrameBuilder::getStats()
+{
+    stats.pending = pending.size();
+    stats.ready = ready.size();
+    return stats;
+}
+
+}}
@@ -40,8 +40,10 @@ PvaClientMultiMonitorDouble::PvaClientMultiMonitorDouble(
   pvaClientChannelArray(pvaClientChannelArray),
   nchannel(pvaClientChannelArray.size()),
   doubleValue(shared_vector<double>(nchannel,epicsNAN)),
-  pvaClientMonitor(std::vector<PvaClientMonitorPtr>(nchannel,PvaClientMonitorPtr())),
-  isMonitorConnected(false)
+  monitorSet(PvaClientMultiMonitorSet::create(
+      pvaClientMultiChannel,
+      pvaClientChannelArray,
+      pvaClientMultiChannel->getPvaClient()->createRequest("value")))
 {
      if(PvaClient::getDebug()) cout<< "PvaClientMultiMonitorDouble::PvaClientMultiMonitorDouble()\n";
 }
@@ -53,64 +55,34 @@ PvaClientMultiMonitorDouble::~PvaClientMultiMonitorDouble()
 
 void PvaClientMultiMonitorDouble::connect()
 {
-    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
-    string request = "value";
-    for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) {
-               pvaClientMonitor[i] = pvaClientChannelArray[i]->createMonitor(request);
-               pvaClientMonitor[i]->issueConnect();
-         }
-    }
-    for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) {
-               Status status = pvaClientMonitor[i]->waitConnect();
-               if(status.isOK()) continue;
-               string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
-                   + " PvaChannelMonitor::waitConnect " + status.getMessage();
-               throw std::runtime_error(message);
-         }
-    }
-     for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) pvaClientMonitor[i]->start();
-    }
-    isMonitorConnected = true;
+    monitorSet->check();
 }
 
-bool PvaClientMultiMonitorDouble::poll()
+bool PvaClientMultiMonitorDouble::pollReady()
 {
-    if(!isMonitorConnected){
-         connect();
-         epicsThreadSleep(.1);
-    }
     bool result = false;
-    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
-    for(size_t i=0; i<nchannel; ++i)
+    for(size_t j=0; j<readyChannels.size(); ++j)
     {
-         if(isConnected[i]) {
-              if(!pvaClientMonitor[i]){
-                  pvaClientMonitor[i] = pvaClientChannelArray[i]->createMonitor("value");
-                  pvaClientMonitor[i]->issueConnect();
-                  Status status = pvaClientMonitor[i]->waitConnect();
-                  if(!status.isOK()) {
-                     string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
-                        + " PvaChannelMonitor::waitConnect " + status.getMessage();
-                     throw std::runtime_error(message);
-                  }   
-                  pvaClientMonitor[i]->start();
-              }    
-              if(pvaClientMonitor[i]->poll()) {
-                   doubleValue[i] = pvaClientMonitor[i]->getData()->getDouble();
-                   pvaClientMonitor[i]->releaseEvent();
-                   result = true;
-              }
+         size_t i = readyChannels[j];
+         PvaClientMonitorPtr monitor(monitorSet->getMonitor(i));
+         // the selector reports a monitor again only after its next event, so take all events
+         while(monitor->poll()) {
+              doubleValue[i] = monitor->getData()->getDouble();
+              monitor->releaseEvent();
+              result = true;
          }
     }
+    readyChannels.clear();
     return result;
 }
 
+bool PvaClientMultiMonitorDouble::poll()
+{
+    monitorSet->check();
+    monitorSet->poll(readyChannels);
+    return pollReady();
+}
+
 bool PvaClientMultiMonitorDouble::waitEvent(double waitForEvent)
 {
     if(poll()) return true;
@@ -118,11 +90,11 @@ bool PvaClientMultiMonitorDouble::waitEvent(double waitForEvent)
     start.getCurrent();
     TimeStamp now;
     while(true) {
-          epicsThreadSleep(.1);
-          if(poll()) return true;
           now.getCurrent();
-          double diff = TimeStamp::diff(now,start);
-          if(diff>=waitForEvent) break;
+          double remaining = waitForEvent - TimeStamp::diff(now,start);
+          if(remaining<=0.0) break;
+          if(monitorSet->wait(readyChannels,remaining)==0) break;
+          if(pollReady()) return true;
     }
     return false;
 }
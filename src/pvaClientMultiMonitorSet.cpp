@@ -0,0 +1,142 @@
+/* pvaClientMultiMonitorSet.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClientMultiChannel.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+PvaClientMultiMonitorSetPtr PvaClientMultiMonitorSet::create(
+    PvaClientMultiChannelPtr const &pvaMultiChannel,
+    PvaClientChannelArray const &pvaClientChannelArray,
+    PVStructurePtr const &  pvRequest)
+{
+    return PvaClientMultiMonitorSetPtr(
+        new PvaClientMultiMonitorSet(pvaMultiChannel,pvaClientChannelArray,pvRequest));
+}
+
+PvaClientMultiMonitorSet::PvaClientMultiMonitorSet(
+     PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+     PvaClientChannelArray const &pvaClientChannelArray,
+     PVStructurePtr const &  pvRequest)
+: pvaClientMultiChannel(pvaClientMultiChannel),
+  pvaClientChannelArray(pvaClientChannelArray),
+  pvRequest(pvRequest),
+  nchannel(pvaClientChannelArray.size()),
+  pvaClientMonitor(std::vector<PvaClientMonitorPtr>(nchannel,PvaClientMonitorPtr())),
+  isStarted(false),
+  numberMonitors(0),
+  connectionVersion(0),
+  selector(PvaClientMonitorSelector::create())
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiMonitorSet::PvaClientMultiMonitorSet()\n";
+}
+
+PvaClientMultiMonitorSet::~PvaClientMultiMonitorSet()
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiMonitorSet::~PvaClientMultiMonitorSet()\n";
+}
+
+bool PvaClientMultiMonitorSet::removeStopped()
+{
+    // a monitor that was stopped is no longer registered with the selector
+    if(selector->getNumberMonitors()==numberMonitors) return false;
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         PvaClientMonitorPtr const & monitor = pvaClientMonitor[i];
+         if(!monitor || selector->contains(monitor)) continue;
+         monitorIndex.erase(monitor.get());
+         pvaClientMonitor[i].reset();
+         --numberMonitors;
+    }
+    return true;
+}
+
+void PvaClientMultiMonitorSet::check()
+{
+    // the slot of a stopped monitor is filled again if its channel is connected
+    bool removed = removeStopped();
+    // only channels that were not connected before need a scan
+    if(numberMonitors==nchannel) return;
+    // and only after a channel has connected or disconnected
+    size_t version = pvaClientMultiChannel->getConnectionVersion();
+    if(isStarted && version==connectionVersion && !removed) return;
+    isStarted = true;
+    connectionVersion = version;
+    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
+    std::vector<size_t> added;
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i] && !pvaClientMonitor[i]) {
+               pvaClientMonitor[i] = pvaClientChannelArray[i]->createMonitor(pvRequest);
+               pvaClientMonitor[i]->issueConnect();
+               added.push_back(i);
+         }
+    }
+    for(size_t j=0; j<added.size(); ++j)
+    {
+         size_t i = added[j];
+         Status status = pvaClientMonitor[i]->waitConnect();
+         if(status.isOK()) continue;
+         // the next check tries again
+         for(size_t k=0; k<added.size(); ++k) pvaClientMonitor[added[k]].reset();
+         string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
+             + " PvaChannelMonitor::waitConnect " + status.getMessage();
+         throw std::runtime_error(message);
+    }
+    for(size_t j=0; j<added.size(); ++j)
+    {
+         size_t i = added[j];
+         PvaClientMonitorPtr const & monitor = pvaClientMonitor[i];
+         monitor->start();
+         monitorIndex[monitor.get()] = i;
+         ++numberMonitors;
+         selector->add(monitor);
+    }
+}
+
+size_t PvaClientMultiMonitorSet::toIndex(std::vector<size_t> & ready)
+{
+    ready.clear();
+    for(size_t j=0; j<readyMonitors.size(); ++j)
+    {
+         std::map<PvaClientMonitor *,size_t>::iterator iter
+             = monitorIndex.find(readyMonitors[j].get());
+         if(iter!=monitorIndex.end()) ready.push_back(iter->second);
+    }
+    readyMonitors.clear();
+    return ready.size();
+}
+
+size_t PvaClientMultiMonitorSet::poll(std::vector<size_t> & ready)
+{
+    selector->poll(readyMonitors);
+    return toIndex(ready);
+}
+
+size_t PvaClientMultiMonitorSet::wait(std::vector<size_t> & ready,double secondsToWait)
+{
+    // the selector waits forever for 0.0
+    if(secondsToWait<=0.0) return poll(ready);
+    selector->wait(readyMonitors,secondsToWait);
+    return toIndex(ready);
+}
+
+PvaClientMonitorPtr PvaClientMultiMonitorSet::getMonitor(size_t index)
+{
+    return pvaClientMonitor[index];
+}
+
+}}
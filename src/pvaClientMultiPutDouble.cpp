@@ -91,6 +91,8 @@ void PvaClientMultiPutDouble::put(shared_vector<double> const &data)
                PVScalarPtr pvScalar= pvTop->getSubField<PVScalar>("value");
                if(pvScalar && ScalarTypeFunc::isNumeric(pvScalar->getScalar()->getScalarType())) {
                    getConvert()->fromDouble(pvScalar,data[i]);
+                   // without post handlers nothing else records the change
+                   pvaClientPut[i]->getData()->getChangedBitSet()->set(pvScalar->getFieldOffset());
                    pvaClientPut[i]->issuePut();
                } else {
                    string message = string("channel ")
@@ -0,0 +1,383 @@
+/* pvaClientMultiTyped.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <epicsMath.h>
+#include <pv/timeStamp.h>
+
+#define epicsExportSharedSymbols
+
+#include <pv/pvaClientMultiChannel.h>
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::nt;
+using namespace std;
+
+namespace epics { namespace pvaClient {
+
+template<typename T>
+static T defaultValue() { return T(); }
+template<>
+float defaultValue<float>() { return epicsNAN; }
+template<>
+double defaultValue<double>() { return epicsNAN; }
+
+// get and put the value field of a channel for a scalar type T
+template<typename T>
+struct PvaClientMultiValue
+{
+    static T initial() { return defaultValue<T>(); }
+    static bool get(PVStructurePtr const & pvStructure,T & value)
+    {
+        PVScalarPtr pvScalar(pvStructure->getSubField<PVScalar>("value"));
+        if(!pvScalar) return false;
+        if(pvScalar->getScalar()->getScalarType()==static_cast<ScalarType>(ScalarTypeID<T>::value)) {
+            value = static_cast<PVScalarValue<T> *>(pvScalar.get())->get();
+            return true;
+        }
+        try {
+            value = pvScalar->getAs<T>();
+        } catch (std::exception&) {
+            return false;
+        }
+        return true;
+    }
+    static bool put(PVStructurePtr const & pvStructure,BitSetPtr const & changed,T const & value)
+    {
+        PVScalarPtr pvScalar(pvStructure->getSubField<PVScalar>("value"));
+        if(!pvScalar) return false;
+        // without post handlers nothing else records the change
+        changed->set(pvScalar->getFieldOffset());
+        if(pvScalar->getScalar()->getScalarType()==static_cast<ScalarType>(ScalarTypeID<T>::value)) {
+            static_cast<PVScalarValue<T> *>(pvScalar.get())->put(value);
+        } else {
+            pvScalar->putFrom<T>(value);
+        }
+        return true;
+    }
+};
+
+// an array value field; a field of the same element type is shared, not copied
+template<typename E>
+struct PvaClientMultiValue<shared_vector<const E> >
+{
+    static shared_vector<const E> initial() { return shared_vector<const E>(); }
+    static bool get(PVStructurePtr const & pvStructure,shared_vector<const E> & value)
+    {
+        PVScalarArrayPtr pvArray(pvStructure->getSubField<PVScalarArray>("value"));
+        if(!pvArray) return false;
+        if(pvArray->getScalarArray()->getElementType()==static_cast<ScalarType>(ScalarTypeID<E>::value)) {
+            value = static_cast<PVValueArray<E> *>(pvArray.get())->view();
+            return true;
+        }
+        try {
+            pvArray->getAs<E>(value);
+        } catch (std::exception&) {
+            return false;
+        }
+        return true;
+    }
+    static bool put(PVStructurePtr const & pvStructure,BitSetPtr const & changed,
+        shared_vector<const E> const & value)
+    {
+        PVScalarArrayPtr pvArray(pvStructure->getSubField<PVScalarArray>("value"));
+        if(!pvArray) return false;
+        changed->set(pvArray->getFieldOffset());
+        if(pvArray->getScalarArray()->getElementType()==static_cast<ScalarType>(ScalarTypeID<E>::value)) {
+            static_cast<PVValueArray<E> *>(pvArray.get())->replace(value);
+        } else {
+            pvArray->putFrom<E>(value);
+        }
+        return true;
+    }
+};
+
+template<typename T>
+typename PvaClientMultiGet<T>::shared_pointer PvaClientMultiGet<T>::create(
+    PvaClientMultiChannelPtr const &pvaMultiChannel,
+    PvaClientChannelArray const &pvaClientChannelArray)
+{
+    return shared_pointer(new PvaClientMultiGet<T>(pvaMultiChannel,pvaClientChannelArray));
+}
+
+template<typename T>
+PvaClientMultiGet<T>::PvaClientMultiGet(
+     PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+     PvaClientChannelArray const &pvaClientChannelArray)
+: pvaClientMultiChannel(pvaClientMultiChannel),
+  pvaClientChannelArray(pvaClientChannelArray),
+  nchannel(pvaClientChannelArray.size()),
+  value(shared_vector<T>(nchannel,PvaClientMultiValue<T>::initial())),
+  pvaClientGet(std::vector<PvaClientGetPtr>(nchannel,PvaClientGetPtr())),
+  isGetConnected(false)
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiGet::PvaClientMultiGet()\n";
+}
+
+template<typename T>
+PvaClientMultiGet<T>::~PvaClientMultiGet()
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiGet::~PvaClientMultiGet()\n";
+}
+
+template<typename T>
+void PvaClientMultiGet<T>::connect()
+{
+    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               pvaClientGet[i] = pvaClientChannelArray[i]->createGet("value");
+               pvaClientGet[i]->issueConnect();
+         }
+    }
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               Status status = pvaClientGet[i]->waitConnect();
+               if(status.isOK()) continue;
+               string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
+                   + " PvaChannelGet::waitConnect " + status.getMessage();
+               throw std::runtime_error(message);
+         }
+    }
+    isGetConnected = true;
+}
+
+template<typename T>
+shared_vector<T> PvaClientMultiGet<T>::get()
+{
+    if(!isGetConnected) connect();
+    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               if(!pvaClientGet[i]) pvaClientGet[i]=pvaClientChannelArray[i]->createGet("value");
+               pvaClientGet[i]->issueGet();
+         }
+    }
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               Status status = pvaClientGet[i]->waitGet();
+               if(status.isOK()) continue;
+               string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
+                   + " PvaChannelGet::waitGet " + status.getMessage();
+               throw std::runtime_error(message);
+         }
+    }
+    // a caller may still hold the array returned by the previous get
+    value.make_unique();
+    for(size_t i=0; i<nchannel; ++i)
+    {
+        if(isConnected[i]
+        && PvaClientMultiValue<T>::get(pvaClientGet[i]->getData()->getPVStructure(),value[i]))
+        {
+            continue;
+        }
+        value[i] = PvaClientMultiValue<T>::initial();
+    }
+    return value;
+}
+
+template<typename T>
+typename PvaClientMultiPut<T>::shared_pointer PvaClientMultiPut<T>::create(
+    PvaClientMultiChannelPtr const &pvaMultiChannel,
+    PvaClientChannelArray const &pvaClientChannelArray)
+{
+    return shared_pointer(new PvaClientMultiPut<T>(pvaMultiChannel,pvaClientChannelArray));
+}
+
+template<typename T>
+PvaClientMultiPut<T>::PvaClientMultiPut(
+     PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+     PvaClientChannelArray const &pvaClientChannelArray)
+: pvaClientMultiChannel(pvaClientMultiChannel),
+  pvaClientChannelArray(pvaClientChannelArray),
+  nchannel(pvaClientChannelArray.size()),
+  pvaClientPut(std::vector<PvaClientPutPtr>(nchannel,PvaClientPutPtr())),
+  isPutConnected(false)
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiPut::PvaClientMultiPut()\n";
+}
+
+template<typename T>
+PvaClientMultiPut<T>::~PvaClientMultiPut()
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiPut::~PvaClientMultiPut()\n";
+}
+
+template<typename T>
+void PvaClientMultiPut<T>::connect()
+{
+    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               pvaClientPut[i] = pvaClientChannelArray[i]->createPut("value");
+               pvaClientPut[i]->issueConnect();
+         }
+    }
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               Status status = pvaClientPut[i]->waitConnect();
+               if(status.isOK()) continue;
+               string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
+                   + " PvaChannelPut::waitConnect " + status.getMessage();
+               throw std::runtime_error(message);
+         }
+    }
+    isPutConnected = true;
+}
+
+template<typename T>
+void PvaClientMultiPut<T>::put(shared_vector<T> const &data)
+{
+    if(!isPutConnected) connect();
+    if(data.size()!=nchannel) {
+         throw std::runtime_error("data has wrong size");
+    }
+    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+               if(!pvaClientPut[i]) pvaClientPut[i]=pvaClientChannelArray[i]->createPut("value");
+               PvaClientPutDataPtr putData(pvaClientPut[i]->getData());
+               if(!PvaClientMultiValue<T>::put(putData->getPVStructure(),
+                   putData->getChangedBitSet(),data[i])) {
+                   string message = string("channel ")
+                       + pvaClientChannelArray[i]->getChannelName()
+                       + " does not have a value field of the requested type";
+                   throw std::runtime_error(message);
+               }
+               pvaClientPut[i]->issuePut();
+         }
+    }
+    for(size_t i=0; i<nchannel; ++i)
+    {
+         if(isConnected[i]) {
+              Status status = pvaClientPut[i]->waitPut();
+              if(status.isOK())  continue;
+              string message = string("channel ") + pvaClientChannelArray[i]->getChannelName()
+                   + " PvaChannelPut::waitPut " + status.getMessage();
+              throw std::runtime_error(message);
+         }
+    }
+}
+
+template<typename T>
+typename PvaClientMultiMonitor<T>::shared_pointer PvaClientMultiMonitor<T>::create(
+    PvaClientMultiChannelPtr const &pvaMultiChannel,
+    PvaClientChannelArray const &pvaClientChannelArray)
+{
+    return shared_pointer(new PvaClientMultiMonitor<T>(pvaMultiChannel,pvaClientChannelArray));
+}
+
+template<typename T>
+PvaClientMultiMonitor<T>::PvaClientMultiMonitor(
+     PvaClientMultiChannelPtr const &pvaClientMultiChannel,
+     PvaClientChannelArray const &pvaClientChannelArray)
+: pvaClientMultiChannel(pvaClientMultiChannel),
+  pvaClientChannelArray(pvaClientChannelArray),
+  nchannel(pvaClientChannelArray.size()),
+  value(shared_vector<T>(nchannel,PvaClientMultiValue<T>::initial())),
+  monitorSet(PvaClientMultiMonitorSet::create(
+      pvaClientMultiChannel,
+      pvaClientChannelArray,
+      pvaClientMultiChannel->getPvaClient()->createRequest("value")))
+{
+     if(PvaClient::getDebug()) cout<< "PvaClientMultiMonitor::PvaClientMultiMonitor()\n";
+}
+
+template<typename T>
+PvaClientMultiMonitor<T>::~PvaClientMultiMonitor()
+{
+    if(PvaClient::getDebug()) cout<< "PvaClientMultiMonitor::~PvaClientMultiMonitor()\n";
+}
+
+template<typename T>
+void PvaClientMultiMonitor<T>::connect()
+{
+    monitorSet->check();
+}
+
+template<typename T>
+bool PvaClientMultiMonitor<T>::pollReady()
+{
+    bool result = false;
+    // a caller may still hold the array returned by get
+    if(!readyChannels.empty()) value.make_unique();
+    for(size_t j=0; j<readyChannels.size(); ++j)
+    {
+         size_t i = readyChannels[j];
+         PvaClientMonitorPtr monitor(monitorSet->getMonitor(i));
+         // the selector reports a monitor again only after its next event, so take all events
+         while(monitor->poll()) {
+              if(!PvaClientMultiValue<T>::get(monitor->getData()->getPVStructure(),value[i])) {
+                  value[i] = PvaClientMultiValue<T>::initial();
+              }
+              monitor->releaseEvent();
+              result = true;
+         }
+    }
+    readyChannels.clear();
+    return result;
+}
+
+template<typename T>
+bool PvaClientMultiMonitor<T>::poll()
+{
+    monitorSet->check();
+    monitorSet->poll(readyChannels);
+    return pollReady();
+}
+
+template<typename T>
+bool PvaClientMultiMonitor<T>::waitEvent(double waitForEvent)
+{
+    if(poll()) return true;
+    TimeStamp start;
+    start.getCurrent();
+    TimeStamp now;
+    while(true) {
+          now.getCurrent();
+          double remaining = waitForEvent - TimeStamp::diff(now,start);
+          if(remaining<=0.0) break;
+          if(monitorSet->wait(readyChannels,remaining)==0) break;
+          if(pollReady()) return true;
+    }
+    return false;
+}
+
+template<typename T>
+shared_vector<T> PvaClientMultiMonitor<T>::get()
+{
+    return value;
+}
+
+// epicsShareClass so that the instances are exported from a Windows DLL
+#define PVACLIENT_MULTI_INSTANTIATE(T) \
+template class epicsShareClass PvaClientMultiGet<T>; \
+template class epicsShareClass PvaClientMultiPut<T>; \
+template class epicsShareClass PvaClientMultiMonitor<T>;
+
+PVACLIENT_MULTI_INSTANTIATE(int32)
+PVACLIENT_MULTI_INSTANTIATE(int64)
+PVACLIENT_MULTI_INSTANTIATE(float)
+PVACLIENT_MULTI_INSTANTIATE(double)
+PVACLIENT_MULTI_INSTANTIATE(string)
+PVACLIENT_MULTI_INSTANTIATE(shared_vector<const int32>)
+PVACLIENT_MULTI_INSTANTIATE(shared_vector<const int64>)
+PVACLIENT_MULTI_INSTANTIATE(shared_vector<const float>)
+PVACLIENT_MULTI_INSTANTIATE(shared_vector<const double>)
+PVACLIENT_MULTI_INSTANTIATE(shared_vector<const string>)
+
+}}
@@ -41,12 +41,15 @@ PvaClientNTMultiData::PvaClientNTMultiData(
   pvaClientChannelArray(pvaClientChannelArray),
   nchannel(pvaClientChannelArray.size()),
   gotAlarm(false),
-  gotTimeStamp(false)
-  
+  gotTimeStamp(false),
+  connectionVersion(pvaClientMultiChannel->getConnectionVersion()),
+  alarmChanged(false),
+  timeStampChanged(false)
 {
     if(PvaClient::getDebug()) cout<< "PvaClientNTMultiData::PvaClientNTMultiData()\n";
     changeFlags =  shared_vector<epics::pvData::boolean>(nchannel);
     topPVStructure.resize(nchannel);
+    channelFields.resize(nchannel);
     
     unionValue.resize(nchannel);
     PVDataCreatePtr pvDataCreate = getPVDataCreate();
@@ -79,6 +82,14 @@ PvaClientNTMultiData::PvaClientNTMultiData(
         userTag.resize(nchannel);
     }
     ntMultiChannelStructure = builder->createStructure();
+    for(size_t i=0; i< nchannel; ++i) setDisconnected(i);
+    PVStructurePtr pvStructure = getPVDataCreate()->createPVStructure(ntMultiChannelStructure);
+    ntMultiChannel = NTMultiChannel::wrap(pvStructure);
+    ntMultiChannel->getChannelName()->replace(pvaClientMultiChannel->getChannelNames());
+    // the union of each channel is updated in place so the value column is set once
+    shared_vector<PVUnionPtr> val(nchannel);
+    for(size_t i=0; i<nchannel; ++i) val[i] = unionValue[i];
+    ntMultiChannel->getValue()->replace(freeze(val));
 }
 
 
@@ -90,9 +101,65 @@ PvaClientNTMultiData::~PvaClientNTMultiData()
 void PvaClientNTMultiData::setPVStructure(
         PVStructurePtr const &pvStructure,size_t index)
 {
+    if(!topPVStructure[index]) changedIndex.push_back(index);
     topPVStructure[index] = pvStructure;
 }
 
+static size_t fieldOffset(PVStructurePtr const & pvStructure,string const & name)
+{
+    PVFieldPtr pvField(pvStructure->getSubField(name));
+    return pvField ? pvField->getFieldOffset() : 0;
+}
+
+void PvaClientNTMultiData::resolveFields(size_t index,PVStructurePtr const & pvStructure)
+{
+    ChannelFields & fields = channelFields[index];
+    if(fields.pvStructure==pvStructure) return;
+    fields.pvStructure = pvStructure;
+    if(fields.structure!=pvStructure->getStructure()) {
+        // a new type; offset 0 is the top level structure so it means not present
+        fields.structure = pvStructure->getStructure();
+        fields.valueOffset = fieldOffset(pvStructure,"value");
+        fields.severityOffset = fieldOffset(pvStructure,"alarm.severity");
+        fields.statusOffset = fieldOffset(pvStructure,"alarm.status");
+        fields.messageOffset = fieldOffset(pvStructure,"alarm.message");
+        fields.secondsPastEpochOffset = fieldOffset(pvStructure,"timeStamp.secondsPastEpoch");
+        fields.nanosecondsOffset = fieldOffset(pvStructure,"timeStamp.nanoseconds");
+        fields.userTagOffset = fieldOffset(pvStructure,"timeStamp.userTag");
+    }
+    fields.pvValue = fields.valueOffset ? pvStructure->getSubField(fields.valueOffset) : PVFieldPtr();
+    fields.pvSeverity = fields.severityOffset
+        ? pvStructure->getSubField<PVInt>(fields.severityOffset) : PVIntPtr();
+    fields.pvStatus = fields.statusOffset
+        ? pvStructure->getSubField<PVInt>(fields.statusOffset) : PVIntPtr();
+    fields.pvMessage = fields.messageOffset
+        ? pvStructure->getSubField<PVString>(fields.messageOffset) : PVStringPtr();
+    fields.pvSecondsPastEpoch = fields.secondsPastEpochOffset
+        ? pvStructure->getSubField<PVLong>(fields.secondsPastEpochOffset) : PVLongPtr();
+    fields.pvNanoseconds = fields.nanosecondsOffset
+        ? pvStructure->getSubField<PVInt>(fields.nanosecondsOffset) : PVIntPtr();
+    fields.pvUserTag = fields.userTagOffset
+        ? pvStructure->getSubField<PVInt>(fields.userTagOffset) : PVIntPtr();
+}
+
+void PvaClientNTMultiData::setDisconnected(size_t index)
+{
+    if(gotAlarm)
+    {
+        severity[index] = invalidAlarm;
+        status[index] = undefinedStatus;
+        message[index] = "not connected";
+        alarmChanged = true;
+    }
+    if(gotTimeStamp)
+    {
+        secondsPastEpoch[index] = 0;
+        nanoseconds[index] = 0;
+        userTag[index] = 0;
+        timeStampChanged = true;
+    }
+}
+
 shared_vector<epics::pvData::boolean> PvaClientNTMultiData::getChannelChangeFlags()
 {
     return changeFlags;
@@ -107,73 +174,101 @@ size_t PvaClientNTMultiData::getNumber()
 
 void PvaClientNTMultiData::startDeltaTime()
 {
-    for(size_t i=0; i<nchannel; ++i)
+    for(size_t j=0; j<changedIndex.size(); ++j) topPVStructure[changedIndex[j]].reset();
+    changedIndex.clear();
+    if(gotAlarm)
+    {
+        alarm.setSeverity(noAlarm);
+        alarm.setStatus(noStatus);
+        alarm.setMessage("");
+    }
+    if(gotTimeStamp) timeStamp.getCurrent();
+}
+
+
+void PvaClientNTMultiData::endDeltaTime(bool valueOnly)
+{
+    // copy on write: arrays handed out by getChannelChangeFlags and getNTMultiChannel
+    // keep their contents
+    changeFlags.make_unique();
+    for(size_t j=0; j<lastChanged.size(); ++j) changeFlags[lastChanged[j]] = false;
+    lastChanged.clear();
+    if(!changedIndex.empty())
     {
-        topPVStructure[i] = PVStructurePtr();
         if(gotAlarm)
         {
-            alarm.setSeverity(noAlarm);
-            alarm.setStatus(noStatus);
-            alarm.setMessage("");
-            severity[i] = invalidAlarm;
-            status[i] = undefinedStatus;
-            message[i] = "not connected";
+            severity.make_unique();
+            status.make_unique();
+            message.make_unique();
         }
         if(gotTimeStamp)
         {
-            timeStamp.getCurrent();
-            secondsPastEpoch[i] = 0;
-            nanoseconds[i] = 0;
-            userTag[i] = 0;
+            secondsPastEpoch.make_unique();
+            nanoseconds.make_unique();
+            userTag.make_unique();
         }
     }
-}
-
-
-void PvaClientNTMultiData::endDeltaTime(bool valueOnly)
-{
-    for(size_t i=0; i<nchannel; ++i)
+    for(size_t j=0; j<changedIndex.size(); ++j)
     {
+        size_t i = changedIndex[j];
         PVStructurePtr pvst = topPVStructure[i];
-        changeFlags[i] = false;
-        if(pvst&&unionValue[i]) {
-            changeFlags[i] = true;
-            if(valueOnly) {
-                PVFieldPtr pvValue = pvst->getSubField("value");
-                if(pvValue) {
-                    unionValue[i]->set(pvst->getSubField("value"));
-                }
-            } else {
-                unionValue[i]->set(pvst);
+        topPVStructure[i].reset();
+        if(!unionValue[i]) continue;
+        changeFlags[i] = true;
+        lastChanged.push_back(i);
+        resolveFields(i,pvst);
+        ChannelFields const & fields = channelFields[i];
+        if(valueOnly) {
+            if(fields.pvValue) {
+                unionValue[i]->set(fields.pvValue);
             }
-            if(gotAlarm)
-            {
-                PVIntPtr pvSeverity = pvst->getSubField<PVInt>("alarm.severity");
-                PVIntPtr pvStatus = pvst->getSubField<PVInt>("alarm.status");
-                PVStringPtr pvMessage = pvst->getSubField<PVString>("alarm.message");
-                if(pvSeverity&&pvStatus&&pvMessage) {
-                    severity[i] = pvSeverity->get();
-                    status[i] = pvStatus->get();
-                    message[i] = pvMessage->get();
-                } else {
-                    severity[i] = undefinedAlarm;
-                    status[i] = undefinedStatus;
-                    message[i] = "no alarm field";
-                }
+        } else {
+            unionValue[i]->set(pvst);
+        }
+        if(gotAlarm)
+        {
+            alarmChanged = true;
+            if(fields.pvSeverity&&fields.pvStatus&&fields.pvMessage) {
+                severity[i] = fields.pvSeverity->get();
+                status[i] = fields.pvStatus->get();
+                message[i] = fields.pvMessage->get();
+            } else {
+                severity[i] = undefinedAlarm;
+                status[i] = undefinedStatus;
+                message[i] = "no alarm field";
             }
-            if(gotTimeStamp)
-            {
-                PVLongPtr pvEpoch = pvst->getSubField<PVLong>("timeStamp.secondsPastEpoch");
-                PVIntPtr pvNano = pvst->getSubField<PVInt>("timeStamp.nanoseconds");
-                PVIntPtr pvTag = pvst->getSubField<PVInt>("timeStamp.userTag");
-                if(pvEpoch&&pvNano&&pvTag) {
-                    secondsPastEpoch[i] = pvEpoch->get();
-                    nanoseconds[i] = pvNano->get();
-                    userTag[i] = pvTag->get();
-                }
+        }
+        if(gotTimeStamp)
+        {
+            timeStampChanged = true;
+            if(fields.pvSecondsPastEpoch&&fields.pvNanoseconds&&fields.pvUserTag) {
+                secondsPastEpoch[i] = fields.pvSecondsPastEpoch->get();
+                nanoseconds[i] = fields.pvNanoseconds->get();
+                userTag[i] = fields.pvUserTag->get();
             }
         }
     }
+    changedIndex.clear();
+    // channels that lost their connection no longer report their last alarm and time
+    size_t version = pvaClientMultiChannel->getConnectionVersion();
+    if(version==connectionVersion || (!gotAlarm && !gotTimeStamp)) return;
+    connectionVersion = version;
+    shared_vector<epics::pvData::boolean> connected = pvaClientMultiChannel->getIsConnected();
+    bool madeUnique = false;
+    for(size_t i=0; i<nchannel; ++i)
+    {
+        if(connected[i] || changeFlags[i]) continue;
+        if(!madeUnique) {
+            severity.make_unique();
+            status.make_unique();
+            message.make_unique();
+            secondsPastEpoch.make_unique();
+            nanoseconds.make_unique();
+            userTag.make_unique();
+            madeUnique = true;
+        }
+        setDisconnected(i);
+    }
 }
 
 TimeStamp PvaClientNTMultiData::getTimeStamp()
@@ -184,39 +279,24 @@ TimeStamp PvaClientNTMultiData::getTimeStamp()
 
 NTMultiChannelPtr PvaClientNTMultiData::getNTMultiChannel()
 {
-    PVStructurePtr pvStructure = getPVDataCreate()->createPVStructure(ntMultiChannelStructure);
-    NTMultiChannelPtr ntMultiChannel = NTMultiChannel::wrap(pvStructure);
-    ntMultiChannel->getChannelName()->replace(pvaClientMultiChannel->getChannelNames());
-    shared_vector<PVUnionPtr> val(nchannel);
-    for(size_t i=0; i<nchannel; ++i) val[i] = unionValue[i];
-    ntMultiChannel->getValue()->replace(freeze(val));
     shared_vector<epics::pvData::boolean> connected = pvaClientMultiChannel->getIsConnected();
-    shared_vector<epics::pvData::boolean> isConnected(nchannel);
-    for(size_t i=0; i<nchannel; ++i) isConnected[i] = connected[i];
-    ntMultiChannel->getIsConnected()->replace(freeze(isConnected));
-    if(gotAlarm)
+    ntMultiChannel->getIsConnected()->replace(
+        const_shared_vector_cast<const epics::pvData::boolean>(connected));
+    // the replaced arrays are shared; endDeltaTime copies them before the next change
+    if(alarmChanged)
     {
-        shared_vector<int32> sev(nchannel);
-        for(size_t i=0; i<nchannel; ++i) sev[i] = severity[i];
-        ntMultiChannel->getSeverity()->replace(freeze(sev));
-        shared_vector<int32> sta(nchannel);
-        for(size_t i=0; i<nchannel; ++i) sta[i] = status[i];
-        ntMultiChannel->getStatus()->replace(freeze(sta));
-        shared_vector<string> mes(nchannel);
-        for(size_t i=0; i<nchannel; ++i) mes[i] = message[i];
-        ntMultiChannel->getMessage()->replace(freeze(mes));
+        ntMultiChannel->getSeverity()->replace(const_shared_vector_cast<const int32>(severity));
+        ntMultiChannel->getStatus()->replace(const_shared_vector_cast<const int32>(status));
+        ntMultiChannel->getMessage()->replace(const_shared_vector_cast<const string>(message));
+        alarmChanged = false;
     }
-    if(gotTimeStamp)
+    if(timeStampChanged)
     {
-        shared_vector<int64> sec(nchannel);
-        for(size_t i=0; i<nchannel; ++i) sec[i] = secondsPastEpoch[i];
-        ntMultiChannel->getSecondsPastEpoch()->replace(freeze(sec));
-        shared_vector<int32> nano(nchannel);
-        for(size_t i=0; i<nchannel; ++i) nano[i] = nanoseconds[i];
-        ntMultiChannel->getNanoseconds()->replace(freeze(nano));
-        shared_vector<int32> tag(nchannel);
-        for(size_t i=0; i<nchannel; ++i) tag[i] = userTag[i];
-        ntMultiChannel->getUserTag()->replace(freeze(tag));
+        ntMultiChannel->getSecondsPastEpoch()->replace(
+            const_shared_vector_cast<const int64>(secondsPastEpoch));
+        ntMultiChannel->getNanoseconds()->replace(const_shared_vector_cast<const int32>(nanoseconds));
+        ntMultiChannel->getUserTag()->replace(const_shared_vector_cast<const int32>(userTag));
+        timeStampChanged = false;
     }
     return ntMultiChannel;
 }
@@ -51,7 +51,10 @@ PvaClientNTMultiMonitor::PvaClientNTMultiMonitor(
            pvaClientMultiChannel,
            pvaClientChannelArray,
            pvRequest)),
-  isConnected(false)
+  monitorSet(PvaClientMultiMonitorSet::create(
+      pvaClientMultiChannel,
+      pvaClientChannelArray,
+      pvRequest))
 {
     if(PvaClient::getDebug()) cout<< "PvaClientNTMultiMonitor::PvaClientNTMultiMonitor()\n";
 }
@@ -62,61 +65,38 @@ PvaClientNTMultiMonitor::~PvaClientNTMultiMonitor()
     if(PvaClient::getDebug()) cout<< "PvaClientNTMultiMonitor::~PvaClientNTMultiMonitor()\n";
 }
 
-
 void PvaClientNTMultiMonitor::connect()
 {
-    pvaClientMonitor.resize(nchannel);
-    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected();
-    for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) {
-               pvaClientMonitor[i] = pvaClientChannelArray[i]->createMonitor(pvRequest);
-               pvaClientMonitor[i]->issueConnect();
-         }
-    }
-    for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) {
-               Status status = pvaClientMonitor[i]->waitConnect();
-               if(status.isOK()) continue;
-               string message = string("channel ") +pvaClientChannelArray[i]->getChannelName()
-                    + " PvaChannelMonitor::waitConnect " + status.getMessage();
-               throw std::runtime_error(message);
-         }
-    }
-    for(size_t i=0; i<nchannel; ++i)
-    {
-         if(isConnected[i]) pvaClientMonitor[i]->start();
-    }
-    this->isConnected = true;
+    monitorSet->check();
 }
 
-bool PvaClientNTMultiMonitor::poll(bool valueOnly)
+bool PvaClientNTMultiMonitor::pollReady(bool valueOnly)
 {
-    if(!isConnected) connect();
     bool result = false;
-    shared_vector<epics::pvData::boolean> isConnected = pvaClientMultiChannel->getIsConnected(); 
-    pvaClientNTMultiData->startDeltaTime();  
-    for(size_t i=0; i<nchannel; ++i)
+    pvaClientNTMultiData->startDeltaTime();
+    for(size_t j=0; j<readyChannels.size(); ++j)
     {
-         if(isConnected[i]) {
-             if(!pvaClientMonitor[i]){
-                  pvaClientMonitor[i]=pvaClientChannelArray[i]->createMonitor(pvRequest);
-                  pvaClientMonitor[i]->connect();
-                  pvaClientMonitor[i]->start();
-              }    
-              if(pvaClientMonitor[i]->poll()) {  
-                   pvaClientNTMultiData->setPVStructure(
-                       pvaClientMonitor[i]->getData()->getPVStructure(),i);    
-                   pvaClientMonitor[i]->releaseEvent();
-                   result = true;
-              }
+         size_t i = readyChannels[j];
+         PvaClientMonitorPtr monitor(monitorSet->getMonitor(i));
+         // the selector reports a monitor again only after its next event, so take all events
+         while(monitor->poll()) {
+              pvaClientNTMultiData->setPVStructure(monitor->getData()->getPVStructure(),i);
+              monitor->releaseEvent();
+              result = true;
          }
-    } 
-    if(result) pvaClientNTMultiData->endDeltaTime(valueOnly);  
+    }
+    readyChannels.clear();
+    if(result) pvaClientNTMultiData->endDeltaTime(valueOnly);
     return result;
 }
 
+bool PvaClientNTMultiMonitor::poll(bool valueOnly)
+{
+    monitorSet->check();
+    monitorSet->poll(readyChannels);
+    return pollReady(valueOnly);
+}
+
 bool PvaClientNTMultiMonitor::waitEvent(double waitForEvent)
 {
     if(poll()) return true;
@@ -124,11 +104,11 @@ bool PvaClientNTMultiMonitor::waitEvent(double waitForEvent)
     start.getCurrent();
     TimeStamp now;
     while(true) {
-          epicsThreadSleep(.1);
-          if(poll()) return true;
           now.getCurrent();
-          double diff = TimeStamp::diff(now,start);
-          if(diff>=waitForEvent) break;
+          double remaining = waitForEvent - TimeStamp::diff(now,start);
+          if(remaining<=0.0) break;
+          if(monitorSet->wait(readyChannels,remaining)==0) break;
+          if(pollReady(true)) return true;
     }
     return false;
 }
@@ -144,6 +144,8 @@ void PvaClientNTMultiPut::put()
                    unionValue[i] = pvDataCreate->createPVUnion(builder->createUnion());
                }
                value[i]->copy(*unionValue[i]->get());
+               // without post handlers nothing else records the change
+               pvaClientPut[i]->getData()->getChangedBitSet()->set(value[i]->getFieldOffset());
                pvaClientPut[i]->issuePut();
          }
     }
@@ -142,7 +142,8 @@ void PvaClientProcess::channelProcessConnect(
     }
     PvaClientProcessRequesterPtr  req(pvaClientProcessRequester.lock());
     if(req) {
-          req->channelProcessConnect(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientProcessRequester::channelProcessConnect,
+              status,shared_from_this());
     }
 }
 
@@ -156,16 +157,21 @@ void PvaClientProcess::processDone(
            << " status.isOK " << (status.isOK() ? "true" : "false")
            << endl;
     }
+    PvaClientFuturePtr future;
     {
         Lock xx(mutex);
         channelProcessStatus = status;
         processState = processComplete;
-        waitForProcess.signal();
+        // a process issued by processAsync is waited for with its future, not waitProcess
+        future.swap(this->future);
+        if(!future && waitForProcess) waitForProcess->signal();
     }
     PvaClientProcessRequesterPtr  req(pvaClientProcessRequester.lock());
     if(req) {
-          req->processDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientProcessRequester::processDone,
+              status,shared_from_this());
     }
+    if(future) future->complete(status);
 }
 
 void PvaClientProcess::connect()
@@ -250,11 +256,48 @@ Status PvaClientProcess::waitProcess()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForProcess.wait();
+    while(true) {
+        EventPtr event;
+        {
+            Lock xx(mutex);
+            if(processState!=processActive) break;
+            if(!waitForProcess) waitForProcess = EventPtr(new Event());
+            event = waitForProcess;
+        }
+        event->wait();
+    }
     processState = processComplete;
     return channelProcessStatus;
 }
 
+PvaClientFuturePtr PvaClientProcess::processAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientProcess::processAsync"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << endl;
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    future->setOwner(shared_from_this());
+    {
+        Lock xx(mutex);
+        if(this->future) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientProcess::processAsync process aleady active ";
+            throw std::runtime_error(message);
+        }
+        this->future = future;
+    }
+    try {
+        issueProcess();
+    } catch (...) {
+        Lock xx(mutex);
+        this->future.reset();
+        throw;
+    }
+    return future;
+}
+
 void PvaClientProcess::setRequester(PvaClientProcessRequesterPtr const & pvaClientProcessRequester)
 {
     if(PvaClient::getDebug()) {
@@ -163,14 +163,17 @@ void PvaClientPut::channelPutConnect(
         if(status.isOK()) {
             this->channelPut = channelPut;
             connectState = connected;
-            pvaClientData = PvaClientPutData::create(structure);
+            PvaClientPtr client(pvaClient.lock());
+            pvaClientData = PvaClientPutData::create(
+                structure,client ? client->getPutPostHandlers() : true);
             pvaClientData->setMessagePrefix(channelPut->getChannel()->getChannelName());
         }    
         waitForConnect.signal();
     }
     PvaClientPutRequesterPtr  req(pvaClientPutRequester.lock());
     if(req) {
-          req->channelPutConnect(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutRequester::channelPutConnect,
+              status,shared_from_this());
     }
 }
 
@@ -197,11 +200,12 @@ void PvaClientPut::getDone(
             *bs |= *bitSet;
         }    
         putState = putComplete;
-        waitForGetPut.signal();
+        if(waitForGetPut) waitForGetPut->signal();
     }
     PvaClientPutRequesterPtr  req(pvaClientPutRequester.lock());
     if(req) {
-          req->getDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutRequester::getDone,
+              status,shared_from_this());
     }
 }
 
@@ -215,14 +219,23 @@ void PvaClientPut::putDone(
            << " status.isOK " << (status.isOK() ? "true" : "false")
            << endl;
     }
+    PvaClientFuturePtr future;
     {
         Lock xx(mutex);
         channelGetPutStatus = status;
         putState = putComplete;
-        waitForGetPut.signal();
+        // a put issued by putAsync is waited for with its future, not waitPut
+        future.swap(this->future);
+        // as waitPut does, the fields that were sent are no longer changed
+        if(future && status.isOK()) pvaClientData->getChangedBitSet()->clear();
+        if(!future && waitForGetPut) waitForGetPut->signal();
     }
     PvaClientPutRequesterPtr  req(pvaClientPutRequester.lock());
-    if(req) { req->putDone(status,shared_from_this());}
+    if(req) {
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutRequester::putDone,
+              status,shared_from_this());
+    }
+    if(future) future->complete(status,PvaClientGetDataPtr(),pvaClientData);
 }
 
 void PvaClientPut::connect()
@@ -313,7 +326,7 @@ Status PvaClientPut::waitGet()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForGetPut.wait();
+    waitDone();
     putState = putComplete;
     return channelGetPutStatus;
 }
@@ -362,12 +375,54 @@ Status PvaClientPut::waitPut()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForGetPut.wait();
+    waitDone();
     putState = putComplete;
     if(channelGetPutStatus.isOK()) pvaClientData->getChangedBitSet()->clear();
     return channelGetPutStatus;
 }
 
+void PvaClientPut::waitDone()
+{
+    while(true) {
+        EventPtr event;
+        {
+            Lock xx(mutex);
+            if(putState!=getActive && putState!=putActive) break;
+            if(!waitForGetPut) waitForGetPut = EventPtr(new Event());
+            event = waitForGetPut;
+        }
+        event->wait();
+    }
+}
+
+PvaClientFuturePtr PvaClientPut::putAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientPut::putAsync"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << endl;
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    future->setOwner(shared_from_this());
+    {
+        Lock xx(mutex);
+        if(this->future) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientPut::putAsync put aleady active ";
+            throw std::runtime_error(message);
+        }
+        this->future = future;
+    }
+    try {
+        issuePut();
+    } catch (...) {
+        Lock xx(mutex);
+        this->future.reset();
+        throw;
+    }
+    return future;
+}
+
 PvaClientPutDataPtr PvaClientPut::getData()
 {
     if(PvaClient::getDebug()) {
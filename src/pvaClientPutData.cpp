@@ -18,6 +18,7 @@
 #define epicsExportSharedSymbols
 
 #include <pv/pvaClient.h>
+#include "pvaClientConvert.h"
 
 using std::tr1::static_pointer_cast;
 using namespace epics::pvData;
@@ -41,20 +42,23 @@ public:
 };
 
 
-PvaClientPutDataPtr PvaClientPutData::create(StructureConstPtr const & structure)
+PvaClientPutDataPtr PvaClientPutData::create(
+    StructureConstPtr const & structure,
+    bool postHandlers)
 {
     if(PvaClient::getDebug()) cout << "PvaClientPutData::create\n";
-    PvaClientPutDataPtr epv(new PvaClientPutData(structure));
+    PvaClientPutDataPtr epv(new PvaClientPutData(structure,postHandlers));
     return epv;
 }
 
-PvaClientPutData::PvaClientPutData(StructureConstPtr const & structure)
+PvaClientPutData::PvaClientPutData(StructureConstPtr const & structure,bool postHandlers)
 : PvaClientData(structure)
 {
     if(PvaClient::getDebug()) cout << "PvaClientPutData::PvaClientPutData\n";
     PVStructurePtr pvStructure(getPVDataCreate()->createPVStructure(structure));
     BitSetPtr bitSet(BitSetPtr(new BitSet(pvStructure->getNumberFields())));
     setData(pvStructure,bitSet);
+    if(!postHandlers) return;
     size_t nfields = pvStructure->getNumberFields();
     postHandler.resize(nfields);
     PVFieldPtr pvField;
@@ -82,6 +86,7 @@ void PvaClientPutData::putDouble(double value)
     PVScalarPtr pvScalar = static_pointer_cast<PVScalar>(pvField);
     ScalarType scalarType = pvScalar->getScalar()->getScalarType();
     if(scalarType==pvDouble) {
+        setChanged(pvField);
         PVDoublePtr pvDouble = static_pointer_cast<PVDouble>(pvScalar);
          pvDouble->put(value);
          return;
@@ -90,6 +95,7 @@ void PvaClientPutData::putDouble(double value)
         throw std::logic_error(
             "PvaClientData::putDouble() did not find a numeric scalar field");
     }
+    setChanged(pvField);
     convert->fromDouble(pvScalar,value);
 }
 
@@ -102,6 +108,7 @@ void PvaClientPutData::putString(std::string const & value)
         throw std::logic_error("PvaClientData::putString() did not find a scalar field");
     }
     PVScalarPtr pvScalar = static_pointer_cast<PVScalar>(pvField);
+    setChanged(pvField);
     convert->fromString(pvScalar,value);
 }
 
@@ -119,6 +126,8 @@ void PvaClientPutData::putDoubleArray(shared_vector<const double> const & value)
         throw std::logic_error(
             "PvaClientData::putDoubleArray() did not find a numeric scalarArray field");
     }
+    setChanged(pvField);
+    if(PvaClientConvert::putDoubleArray(pvScalarArray,value)) return;
     pvScalarArray->putFrom<const double>(value);
 }
 
@@ -131,6 +140,7 @@ void PvaClientPutData::putStringArray(shared_vector<const std::string> const & v
         throw std::logic_error("PvaClientData::putStringArray() did not find a scalarArray field");
     }
     PVScalarArrayPtr pvScalarArray = static_pointer_cast<PVScalarArray>(pvField);
+    setChanged(pvField);
     pvScalarArray->putFrom<const string>(value);
     return;
 }
@@ -144,11 +154,42 @@ void PvaClientPutData::putStringArray(std::vector<string> const & value)
     return;
 }
 
+void PvaClientPutData::moveDoubleArray(shared_vector<double> & value)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientPutData::moveDoubleArray\n";
+    // freeze requires the only reference to the data
+    value.make_unique();
+    putDoubleArray(freeze(value));
+}
+
+void PvaClientPutData::moveStringArray(shared_vector<string> & value)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientPutData::moveStringArray\n";
+    value.make_unique();
+    putStringArray(freeze(value));
+}
+
+void PvaClientPutData::moveStringArray(std::vector<string> & value)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientPutData::moveStringArray\n";
+    size_t length = value.size();
+    shared_vector<string> val(length);
+    for(size_t i=0; i < length; ++i) val[i].swap(value[i]);
+    value.clear();
+    putStringArray(freeze(val));
+}
+
 void PvaClientPutData::postPut(size_t fieldNumber)
 {
     if(PvaClient::getDebug()) cout << "PvaClientPutData::postPut\n";
     getChangedBitSet()->set(fieldNumber);
 }
 
+// also done by the PostHandler, if any, but without one this is the only record of the change
+void PvaClientPutData::setChanged(PVFieldPtr const & pvField)
+{
+    getChangedBitSet()->set(pvField->getFieldOffset());
+}
+
 
 }}
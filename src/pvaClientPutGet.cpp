@@ -176,7 +176,9 @@ void PvaClientPutGet::channelPutGetConnect(
         if(status.isOK()) {
             this->channelPutGet = channelPutGet;
             connectState = connected;
-            pvaClientPutData = PvaClientPutData::create(putStructure);
+            PvaClientPtr client(pvaClient.lock());
+            pvaClientPutData = PvaClientPutData::create(
+                putStructure,client ? client->getPutPostHandlers() : true);
             pvaClientPutData->setMessagePrefix(channelPutGet->getChannel()->getChannelName());
             pvaClientGetData = PvaClientGetData::create(getStructure);
             pvaClientGetData->setMessagePrefix(channelPutGet->getChannel()->getChannelName());
@@ -185,7 +187,8 @@ void PvaClientPutGet::channelPutGetConnect(
     }
     PvaClientPutGetRequesterPtr  req(pvaClientPutGetRequester.lock());
     if(req) {
-          req->channelPutGetConnect(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutGetRequester::channelPutGetConnect,
+              status,shared_from_this());
     }
 }
 
@@ -201,6 +204,7 @@ void PvaClientPutGet::putGetDone(
            << " status.isOK " << (status.isOK() ? "true" : "false")
            << endl;
     }
+    PvaClientFuturePtr future;
     {
         Lock xx(mutex);
         channelPutGetStatus = status;
@@ -208,12 +212,18 @@ void PvaClientPutGet::putGetDone(
             pvaClientGetData->setData(getPVStructure,getChangedBitSet);
         }
         putGetState = putGetComplete;  
-        waitForPutGet.signal();
+        // a putGet issued by putGetAsync is waited for with its future, not waitPutGet
+        future.swap(this->future);
+        // as waitPutGet does, the fields that were sent are no longer changed
+        if(future && status.isOK()) pvaClientPutData->getChangedBitSet()->clear();
+        if(!future && waitForPutGet) waitForPutGet->signal();
     }
     PvaClientPutGetRequesterPtr  req(pvaClientPutGetRequester.lock());
     if(req) {
-          req->putGetDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutGetRequester::putGetDone,
+              status,shared_from_this());
     }
+    if(future) future->complete(status,pvaClientGetData,pvaClientPutData);
 }
 
 void PvaClientPutGet::getPutDone(
@@ -239,11 +249,12 @@ void PvaClientPutGet::getPutDone(
             *bs |= *putBitSet;
         }
         putGetState = putGetComplete;
-        waitForPutGet.signal();
+        if(waitForPutGet) waitForPutGet->signal();
     }
     PvaClientPutGetRequesterPtr  req(pvaClientPutGetRequester.lock());
     if(req) {
-          req->getPutDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutGetRequester::getPutDone,
+              status,shared_from_this());
     }
 }
 
@@ -266,11 +277,12 @@ void PvaClientPutGet::getGetDone(
             pvaClientGetData->setData(getPVStructure,getChangedBitSet);
         }
         putGetState = putGetComplete;
-        waitForPutGet.signal();
+        if(waitForPutGet) waitForPutGet->signal();
     }
     PvaClientPutGetRequesterPtr  req(pvaClientPutGetRequester.lock());
     if(req) {
-          req->getGetDone(status,shared_from_this());
+          PvaClientExecutor::dispatch(pvaClient,pvaClientChannel.get(),req,&PvaClientPutGetRequester::getGetDone,
+              status,shared_from_this());
     }
 }
 
@@ -364,11 +376,39 @@ Status PvaClientPutGet::waitPutGet()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForPutGet.wait();
+    waitDone();
     if(channelPutGetStatus.isOK()) pvaClientPutData->getChangedBitSet()->clear();
     return channelPutGetStatus;
 }
 
+PvaClientFuturePtr PvaClientPutGet::putGetAsync()
+{
+    if(PvaClient::getDebug()) {
+        cout << "PvaClientPutGet::putGetAsync"
+           << " channelName " << pvaClientChannel->getChannel()->getChannelName()
+           << endl;
+    }
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    future->setOwner(shared_from_this());
+    {
+        Lock xx(mutex);
+        if(this->future) {
+            string message = string("channel ") + pvaClientChannel->getChannel()->getChannelName()
+                + " PvaClientPutGet::putGetAsync putGet aleady active ";
+            throw std::runtime_error(message);
+        }
+        this->future = future;
+    }
+    try {
+        issuePutGet();
+    } catch (...) {
+        Lock xx(mutex);
+        this->future.reset();
+        throw;
+    }
+    return future;
+}
+
 void PvaClientPutGet::getGet()
 {
     if(PvaClient::getDebug()) {
@@ -411,7 +451,7 @@ Status PvaClientPutGet::waitGetGet()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForPutGet.wait();
+    waitDone();
     return channelPutGetStatus;
 }
 
@@ -457,10 +497,24 @@ Status PvaClientPutGet::waitGetPut()
            << " channelName " << pvaClientChannel->getChannel()->getChannelName()
            << endl;
     }
-    waitForPutGet.wait();
+    waitDone();
     return channelPutGetStatus;
 }
 
+void PvaClientPutGet::waitDone()
+{
+    while(true) {
+        EventPtr event;
+        {
+            Lock xx(mutex);
+            if(putGetState!=putGetActive) break;
+            if(!waitForPutGet) waitForPutGet = EventPtr(new Event());
+            event = waitForPutGet;
+        }
+        event->wait();
+    }
+}
+
 PvaClientGetDataPtr PvaClientPutGet::getGetData()
 {
     if(PvaClient::getDebug()) {
@@ -179,6 +179,7 @@ void PvaClientRPC::requestDone(
         PVStructure::shared_pointer const & pvResponse)
 {
     PvaClientRPCRequesterPtr req = pvaClientRPCRequester.lock();
+    PvaClientFuturePtr future;
     {
         Lock xx(mutex);
         requestStatus = status;
@@ -200,17 +201,23 @@ void PvaClientRPC::requestDone(
                  + " but not active";
              throw std::runtime_error(message);
         }
-        if(req && (responseTimeout<=0.0)) {
+        future.swap(this->future);
+        if(future) {
+            rpcState = rpcIdle;
+        } else if(req && (responseTimeout<=0.0)) {
             rpcState = rpcIdle;
         } else {
             rpcState = rpcComplete;
             if(!req) this->pvResponse = pvResponse;
-            waitForDone.signal();
+            if(waitForDone) waitForDone->signal();
         }
     }
     if(req) {
-        req->requestDone(status,shared_from_this(),pvResponse);
+        Channel::shared_pointer chan(channel.lock());
+        PvaClientExecutor::dispatch(pvaClient,chan.get(),req,&PvaClientRPCRequester::requestDone,
+            status,shared_from_this(),pvResponse);
     }
+    if(future) future->complete(status,PvaClientGetDataPtr(),PvaClientPutDataPtr(),pvResponse);
 }
 
 void PvaClientRPC::connect()
@@ -294,10 +301,20 @@ PVStructure::shared_pointer PvaClientRPC::request(PVStructure::shared_pointer co
         rpcState = rpcActive;
     }
     channelRPC->request(pvArgument);
-    if(responseTimeout>0.0) {
-        waitForDone.wait(responseTimeout);
-    } else {
-        waitForDone.wait();
+    EventPtr event;
+    {
+        Lock xx(mutex);
+        if(rpcState==rpcActive) {
+            if(!waitForDone) waitForDone = EventPtr(new Event());
+            event = waitForDone;
+        }
+    }
+    if(event) {
+        if(responseTimeout>0.0) {
+            event->wait(responseTimeout);
+        } else {
+            event->wait();
+        }
     }
     Lock xx(mutex);
     if(rpcState!=rpcComplete) {
@@ -348,5 +365,36 @@ void PvaClientRPC::request(
     request(pvArgument);
 }
 
+PvaClientFuturePtr PvaClientRPC::requestAsync(PVStructure::shared_pointer const & pvArgument)
+{
+    if(PvaClient::getDebug()) cout << "PvaClientRPC::requestAsync\n";
+    checkRPCState();
+    PvaClientFuturePtr future(PvaClientFuture::create());
+    future->setOwner(shared_from_this());
+    {
+        Lock xx(mutex);
+        if(rpcState!=rpcIdle) {
+            Channel::shared_pointer chan(channel.lock());
+            string channelName("disconnected");
+            if(chan) channelName = chan->getChannelName();
+            string message = "channel "
+                + channelName
+                + " PvaClientRPC::requestAsync request aleady active ";
+            throw std::runtime_error(message);
+        }
+        rpcState = rpcActive;
+        this->future = future;
+    }
+    try {
+        channelRPC->request(pvArgument);
+    } catch (...) {
+        Lock xx(mutex);
+        this->future.reset();
+        rpcState = rpcIdle;
+        throw;
+    }
+    return future;
+}
+
 
 }}
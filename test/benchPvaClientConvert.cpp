@@ -0,0 +1,85 @@
+/* benchPvaClientConvert.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+/* Compare the PvaClientConvert loops with a plain loop.
+ * This is built with the tests but is not run by them.
+ * usage: benchPvaClientConvert [length] [repeat]
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <pv/timeStamp.h>
+
+#include "pvaClientConvert.h"
+
+using namespace epics::pvData;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+template<typename From,typename To>
+void plainLoop(const From * from,To * to,size_t length)
+{
+    for(size_t i=0; i<length; ++i) to[i] = static_cast<To>(from[i]);
+}
+
+template<typename From,typename To>
+double seconds(
+    void (*convert)(const From *,To *,size_t),
+    vector<From> const & from,
+    vector<To> & to,
+    size_t repeat)
+{
+    TimeStamp start;
+    start.getCurrent();
+    for(size_t i=0; i<repeat; ++i) convert(&from[0],&to[0],from.size());
+    TimeStamp end;
+    end.getCurrent();
+    return TimeStamp::diff(end,start);
+}
+
+template<typename From,typename To>
+void bench(
+    const char * name,
+    void (*convert)(const From *,To *,size_t),
+    size_t length,
+    size_t repeat)
+{
+    vector<From> from(length);
+    for(size_t i=0; i<length; ++i) from[i] = static_cast<From>(i%1000);
+    vector<To> to(length);
+    double fast = seconds(convert,from,to,repeat);
+    double plain = seconds(&plainLoop<From,To>,from,to,repeat);
+    double elements = double(length)*double(repeat);
+    cout << name
+         << " PvaClientConvert " << fast*1e9/elements << " ns/element"
+         << " plain loop " << plain*1e9/elements << " ns/element"
+         << " speedup " << (fast>0.0 ? plain/fast : 0.0)
+         << endl;
+}
+
+} // namespace
+
+int main(int argc,char *argv[])
+{
+    size_t length = (argc>1) ? strtoul(argv[1],0,0) : 4096;
+    size_t repeat = (argc>2) ? strtoul(argv[2],0,0) : 10000;
+    if(length<1) length = 1;
+    cout << "length " << length << " repeat " << repeat << endl;
+    bench<int16,double>("int16 to double",&PvaClientConvert::toDouble,length,repeat);
+    bench<uint16,double>("uint16 to double",&PvaClientConvert::toDouble,length,repeat);
+    bench<int32,double>("int32 to double",&PvaClientConvert::toDouble,length,repeat);
+    bench<float,double>("float to double",&PvaClientConvert::toDouble,length,repeat);
+    bench<double,float>("double to float",&PvaClientConvert::toFloat,length,repeat);
+    return 0;
+}
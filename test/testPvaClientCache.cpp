@@ -0,0 +1,146 @@
+/* testPvaClientCache.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include <pv/pvaClient.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientCache";
+const char * scalarName = "test:scalar";
+const char * arrayName = "test:array";
+const char * otherName = "test:other";
+
+StructureConstPtr scalarType()
+{
+    return getFieldCreate()->createFieldBuilder()
+        ->add("value",pvDouble)
+        ->add("a",pvDouble)
+        ->add("b",pvDouble)
+        ->createStructure();
+}
+
+StructureConstPtr arrayType()
+{
+    return getFieldCreate()->createFieldBuilder()
+        ->addArray("value",pvDouble)
+        ->createStructure();
+}
+
+void postArray(TestPvaClientServer & server,size_t length)
+{
+    PVDoubleArrayPtr pvArray(server.getValue(arrayName)->getSubFieldT<PVDoubleArray>("value"));
+    PVDoubleArray::svector data(length,1.0);
+    pvArray->replace(freeze(data));
+    BitSet changed;
+    changed.set(pvArray->getFieldOffset());
+    server.post(arrayName,changed);
+}
+
+// the least recently used request is evicted first
+void testRequestEntries(PvaClientPtr const & pvaClient)
+{
+    testDiag("testRequestEntries");
+    PvaClientCacheLimits limits;
+    limits.maxEntries = 2;
+    pvaClient->setRequestCacheLimits(limits);
+    PvaClientChannelPtr pvaClientChannel(pvaClient->channel(scalarName,providerName));
+    pvaClientChannel->get("field(value)");
+    pvaClientChannel->get("field(a)");
+    pvaClientChannel->get("field(value)");
+    pvaClientChannel->get("field(b)");
+    PvaClientCacheStats stats(pvaClientChannel->getCacheStats());
+    testOk(stats.entries==2,"entries %u expected 2",(unsigned)stats.entries);
+    testOk(stats.evictions==1,"evictions %u expected 1",(unsigned)stats.evictions);
+    testOk(stats.hits==1,"hits %u expected 1",(unsigned)stats.hits);
+    testOk(stats.misses==3,"misses %u expected 3",(unsigned)stats.misses);
+    // field(a) was evicted, field(value) was used more recently than field(b)
+    pvaClientChannel->get("field(value)");
+    pvaClientChannel->get("field(a)");
+    stats = pvaClientChannel->getCacheStats();
+    testOk(stats.hits==2,"hits %u expected 2",(unsigned)stats.hits);
+    testOk(stats.misses==4,"misses %u expected 4",(unsigned)stats.misses);
+    testOk(stats.evictions==2,"evictions %u expected 2",(unsigned)stats.evictions);
+    pvaClient->setRequestCacheLimits(PvaClientCacheLimits());
+}
+
+// the size of an entry follows the data after each sweep
+void testRequestBytes(PvaClientPtr const & pvaClient,TestPvaClientServer & server)
+{
+    testDiag("testRequestBytes");
+    PvaClientCacheLimits limits;
+    limits.maxBytes = 1000000;
+    pvaClient->setRequestCacheLimits(limits);
+    postArray(server,10);
+    PvaClientChannelPtr pvaClientChannel(pvaClient->channel(arrayName,providerName));
+    pvaClientChannel->get("field(value)");
+    size_t small = pvaClientChannel->getCacheStats().bytes;
+    testOk(small>=10*sizeof(double),"bytes %u for 10 elements",(unsigned)small);
+    postArray(server,1000);
+    pvaClientChannel->get("field(value)");
+    size_t bytes = pvaClientChannel->getCacheStats().bytes;
+    testOk(bytes==small,"bytes %u not estimated again before a sweep",(unsigned)bytes);
+    pvaClient->setRequestCacheLimits(limits);
+    pvaClientChannel->get("field(value)");
+    bytes = pvaClientChannel->getCacheStats().bytes;
+    testOk(bytes>=small+990*sizeof(double),"bytes %u after a sweep",(unsigned)bytes);
+    // the next sweep evicts the entry that has grown beyond the budget
+    limits.maxBytes = small + 100*sizeof(double);
+    pvaClient->setRequestCacheLimits(limits);
+    PvaClientCacheStats stats(pvaClientChannel->getCacheStats());
+    testOk(stats.entries==0,"entries %u expected 0",(unsigned)stats.entries);
+    testOk(stats.evictions==1,"evictions %u expected 1",(unsigned)stats.evictions);
+    pvaClient->setRequestCacheLimits(PvaClientCacheLimits());
+}
+
+// an evicted channel remains valid for a client that holds it
+void testChannelEntries(PvaClientPtr const & pvaClient,TestPvaClientServer & server)
+{
+    testDiag("testChannelEntries");
+    PvaClientChannelPtr first(pvaClient->channel(scalarName,providerName));
+    PvaClientCacheStats before(pvaClient->getCacheStats());
+    PvaClientCacheLimits limits;
+    limits.maxEntries = 1;
+    pvaClient->setCacheLimits(limits);
+    PvaClientChannelPtr other(pvaClient->channel(otherName,providerName));
+    PvaClientCacheStats stats(pvaClient->getCacheStats());
+    testOk(stats.entries==1,"entries %u expected 1",(unsigned)stats.entries);
+    testOk(stats.evictions>before.evictions,"evictions %u",(unsigned)stats.evictions);
+    server.post(scalarName,7.0);
+    double value = first->get("field(value)")->getData()->getDouble();
+    testOk(value==7.0,"evicted channel get returned %g expected 7",value);
+    // the evicted channel is created again
+    PvaClientChannelPtr again(pvaClient->channel(scalarName,providerName));
+    testOk1(again!=first);
+    pvaClient->setCacheLimits(PvaClientCacheLimits());
+}
+
+} // namespace
+
+MAIN(testPvaClientCache)
+{
+    testPlan(16);
+    TestPvaClientServer server(providerName);
+    server.add(scalarName,scalarType());
+    server.add(arrayName,arrayType());
+    server.add(otherName);
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    testRequestEntries(pvaClient);
+    testRequestBytes(pvaClient,server);
+    testChannelEntries(pvaClient,server);
+    return testDone();
+}
@@ -0,0 +1,114 @@
+/* testPvaClientConvert.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <vector>
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include "pvaClientConvert.h"
+
+using namespace epics::pvData;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+// lengths that cover every tail of the 4 and 8 element vector loops
+const size_t maxLength = 40;
+
+template<typename T>
+vector<T> createData(size_t length,T first,T step)
+{
+    vector<T> data(length+1);
+    T x = first;
+    for(size_t i=0; i<data.size(); ++i) {
+        data[i] = x;
+        x = static_cast<T>(x+step);
+    }
+    return data;
+}
+
+// convert from every start offset, so unaligned loads are also used, and compare with a scalar loop
+template<typename From,typename To>
+bool check(vector<From> const & data,void (*convert)(const From *,To *,size_t))
+{
+    for(size_t offset=0; offset<2; ++offset) {
+        for(size_t length=0; length+offset<data.size() && length<=maxLength; ++length) {
+            // one guard element after the end must not be written
+            vector<To> result(length+1,To(-7));
+            convert(&data[offset],&result[0],length);
+            for(size_t i=0; i<length; ++i) {
+                if(result[i]!=static_cast<To>(data[offset+i])) {
+                    testDiag("length %u offset %u element %u",(unsigned)length,(unsigned)offset,(unsigned)i);
+                    return false;
+                }
+            }
+            if(result[length]!=To(-7)) {
+                testDiag("length %u offset %u wrote past the end",(unsigned)length,(unsigned)offset);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void testInt16()
+{
+    testDiag("testInt16");
+    testOk(check(createData<int16>(maxLength+1,-20,1),&PvaClientConvert::toDouble),
+        "int16 around zero");
+    // sign extension of the largest magnitudes
+    testOk(check(createData<int16>(maxLength+1,-32768,1),&PvaClientConvert::toDouble),
+        "int16 from -32768");
+    testOk(check(createData<int16>(maxLength+1,32767,-1),&PvaClientConvert::toDouble),
+        "int16 from 32767");
+    testOk(check(createData<int16>(maxLength+1,-1,-997),&PvaClientConvert::toDouble),
+        "int16 negative steps");
+}
+
+void testUInt16()
+{
+    testDiag("testUInt16");
+    testOk(check(createData<uint16>(maxLength+1,0,1),&PvaClientConvert::toDouble),
+        "uint16 from 0");
+    // values above 32767 must not be sign extended
+    testOk(check(createData<uint16>(maxLength+1,32760,1),&PvaClientConvert::toDouble),
+        "uint16 across 32767");
+    testOk(check(createData<uint16>(maxLength+1,65535,-1),&PvaClientConvert::toDouble),
+        "uint16 from 65535");
+}
+
+void testInt32()
+{
+    testDiag("testInt32");
+    testOk(check(createData<int32>(maxLength+1,-2147483647-1,104729),&PvaClientConvert::toDouble),
+        "int32 from the minimum");
+    testOk(check(createData<int32>(maxLength+1,2147483647,-104729),&PvaClientConvert::toDouble),
+        "int32 from the maximum");
+}
+
+void testFloat()
+{
+    testDiag("testFloat");
+    testOk(check(createData<float>(maxLength+1,-1.5e10f,7.25e8f),&PvaClientConvert::toDouble),
+        "float to double");
+    testOk(check(createData<double>(maxLength+1,-1.0/3.0,0.1),&PvaClientConvert::toFloat),
+        "double to float");
+}
+
+} // namespace
+
+MAIN(testPvaClientConvert)
+{
+    testPlan(11);
+    testInt16();
+    testUInt16();
+    testInt32();
+    testFloat();
+    return testDone();
+}
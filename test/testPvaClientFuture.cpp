@@ -0,0 +1,104 @@
+/* testPvaClientFuture.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include <pv/pvaClient.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientFuture";
+const char * channelName = "test:double";
+const char * twoFieldName = "test:twoField";
+const char * request = "field(value)";
+
+// getAsync and get share the cached PvaClientGet of the channel
+void testGetAfterGetAsync(
+    PvaClientChannelPtr const & pvaClientChannel,
+    TestPvaClientServer & server)
+{
+    testDiag("testGetAfterGetAsync");
+    server.post(channelName,1.0);
+    PvaClientFuturePtr future(pvaClientChannel->getAsync(request));
+    testOk1(future->wait(5.0));
+    testOk1(future->getStatus().isOK());
+    testOk1(future->getGetData()->getDouble()==1.0);
+    server.post(channelName,2.0);
+    double result = pvaClientChannel->get(request)->getData()->getDouble();
+    testOk(result==2.0,"get after getAsync returned %g expected 2",result);
+    server.post(channelName,3.0);
+    future = pvaClientChannel->getAsync(request);
+    testOk1(future->wait(5.0));
+    testOk1(future->getGetData()->getDouble()==3.0);
+}
+
+StructureConstPtr twoFieldType()
+{
+    return getFieldCreate()->createFieldBuilder()
+        ->add("value",pvDouble)
+        ->add("b",pvDouble)
+        ->createStructure();
+}
+
+void testPutAfterPutAsync(
+    PvaClientChannelPtr const & pvaClientChannel,
+    PvaClientChannelPtr const & twoFieldChannel,
+    TestPvaClientServer & server)
+{
+    testDiag("testPutAfterPutAsync");
+    PvaClientPutPtr pvaClientPut(pvaClientChannel->put(request));
+    pvaClientPut->getData()->putDouble(4.0);
+    PvaClientFuturePtr future(pvaClientPut->putAsync());
+    testOk1(future->wait(5.0));
+    testOk1(future->getStatus().isOK());
+    double result = pvaClientChannel->get(request)->getData()->getDouble();
+    testOk(result==4.0,"get after putAsync returned %g expected 4",result);
+    pvaClientChannel->putDouble(5.0,request);
+    result = pvaClientChannel->get(request)->getData()->getDouble();
+    testOk(result==5.0,"get after put returned %g expected 5",result);
+    // a put after putAsync only sends the fields changed since putAsync
+    pvaClientPut = twoFieldChannel->put("field(value,b)");
+    pvaClientPut->getData()->putDouble(4.0);
+    future = pvaClientPut->putAsync();
+    testOk1(future->wait(5.0));
+    testOk1(future->getStatus().isOK());
+    testOk1(pvaClientPut->getData()->getChangedBitSet()->nextSetBit(0)<0);
+    server.post(twoFieldName,"value",7.0);
+    PVDoublePtr pvb(pvaClientPut->getData()->getPVStructure()->getSubFieldT<PVDouble>("b"));
+    pvb->put(6.0);
+    pvaClientPut->put();
+    PVStructurePtr pvStructure(server.fetch(twoFieldName));
+    result = pvStructure->getSubFieldT<PVDouble>("value")->get();
+    testOk(result==7.0,"value after put of b is %g expected 7",result);
+    result = pvStructure->getSubFieldT<PVDouble>("b")->get();
+    testOk(result==6.0,"b after put of b is %g expected 6",result);
+}
+
+} // namespace
+
+MAIN(testPvaClientFuture)
+{
+    testPlan(15);
+    TestPvaClientServer server(providerName);
+    server.add(channelName,TestPvaClientServer::doubleType(),true);
+    server.add(twoFieldName,twoFieldType(),true);
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    PvaClientChannelPtr pvaClientChannel(pvaClient->channel(channelName,providerName));
+    testGetAfterGetAsync(pvaClientChannel,server);
+    PvaClientChannelPtr twoFieldChannel(pvaClient->channel(twoFieldName,providerName));
+    testPutAfterPutAsync(pvaClientChannel,twoFieldChannel,server);
+    return testDone();
+}
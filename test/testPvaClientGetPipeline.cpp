@@ -0,0 +1,77 @@
+/* testPvaClientGetPipeline.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include <pv/pvaClient.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientGetPipeline";
+const char * channelName = "test:double";
+const size_t depth = 4;
+
+// issue depth gets, each after a new value, and drain them oldest first
+void testDrainInOrder(
+    PvaClientGetPipelinePtr const & pipeline,
+    TestPvaClientServer & server,
+    double first)
+{
+    for(size_t i=0; i<depth; ++i) {
+        server.post(channelName,first+i);
+        pipeline->issueGet();
+    }
+    testOk(pipeline->getOutstanding()==depth,"%u gets outstanding",(unsigned)depth);
+    try {
+        pipeline->issueGet();
+        testFail("issueGet with all gets outstanding did not throw");
+    } catch (std::runtime_error & e) {
+        testPass("issueGet with all gets outstanding throws: %s",e.what());
+    }
+    testOk1(pipeline->getOutstanding()==depth);
+    for(size_t i=0; i<depth; ++i) {
+        Status status(pipeline->waitGet());
+        testOk(status.isOK(),"waitGet %u status %s",(unsigned)i,status.getMessage().c_str());
+        double result = pipeline->getData()->getDouble();
+        testOk(result==first+i,"get %u returned %g expected %g",(unsigned)i,result,first+i);
+    }
+    testOk1(pipeline->getOutstanding()==0);
+}
+
+} // namespace
+
+MAIN(testPvaClientGetPipeline)
+{
+    testPlan(2 + 3*(4+2*depth));
+    TestPvaClientServer server(providerName);
+    server.add(channelName);
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    PvaClientChannelPtr pvaClientChannel(pvaClient->channel(channelName,providerName));
+    PvaClientGetPipelinePtr pipeline(pvaClientChannel->createGetPipeline("field(value)",depth));
+    pipeline->connect();
+    testOk1(pipeline->getDepth()==depth);
+    try {
+        pipeline->waitGet();
+        testFail("waitGet with no get outstanding did not throw");
+    } catch (std::runtime_error & e) {
+        testPass("waitGet with no get outstanding throws: %s",e.what());
+    }
+    // the ring wraps around on the second and third pass
+    testDrainInOrder(pipeline,server,0.0);
+    testDrainInOrder(pipeline,server,10.0);
+    testDrainInOrder(pipeline,server,20.0);
+    return testDone();
+}
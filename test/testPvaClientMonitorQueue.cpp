@@ -0,0 +1,147 @@
+/* testPvaClientMonitorQueue.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <vector>
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+#include <epicsThread.h>
+
+#include <pv/pvaClient.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientMonitorQueue";
+const char * channelName = "test:double";
+const size_t capacity = 3;
+const size_t updates = 6;
+
+class Collector :
+    public PvaClientMonitorVisitor
+{
+public:
+    virtual void visit(
+        PVStructurePtr const & pvStructure,
+        BitSetPtr const & changedBitSet,
+        BitSetPtr const & overrunBitSet)
+    {
+        values.push_back(pvStructure->getSubFieldT<PVDouble>("value")->get());
+        overrun.push_back(overrunBitSet->nextSetBit(0)>=0);
+    }
+    vector<double> values;
+    vector<bool> overrun;
+};
+
+// number of updates that reached the queue
+size_t arrived(PvaClientMonitorQueueStats const & stats,PvaClientMonitor::OverflowPolicy policy)
+{
+    switch(policy) {
+    case PvaClientMonitor::dropOldest: return stats.pushed;
+    case PvaClientMonitor::dropNewest: return stats.pushed + stats.dropped;
+    case PvaClientMonitor::squash: return stats.pushed + stats.squashed;
+    }
+    return 0;
+}
+
+bool waitArrived(
+    PvaClientMonitorPtr const & monitor,
+    PvaClientMonitor::OverflowPolicy policy,
+    size_t count)
+{
+    for(int i=0; i<500; ++i) {
+        if(arrived(monitor->getQueueStats(),policy)>=count) return true;
+        epicsThreadSleep(.01);
+    }
+    return false;
+}
+
+// post updates one at a time without polling, then drain the queue
+Collector fill(
+    PvaClientChannelPtr const & pvaClientChannel,
+    TestPvaClientServer & server,
+    PvaClientMonitor::OverflowPolicy policy)
+{
+    server.post(channelName,0.0);
+    PvaClientMonitorPtr monitor(pvaClientChannel->createMonitor("field(value)"));
+    monitor->setQueue(capacity,policy);
+    monitor->connect();
+    monitor->start();
+    // the first update is the current value
+    bool ok = waitArrived(monitor,policy,1);
+    for(size_t i=1; ok && i<updates; ++i) {
+        server.post(channelName,double(i));
+        ok = waitArrived(monitor,policy,i+1);
+    }
+    testOk(ok,"%u updates arrived",(unsigned)updates);
+    Collector collector;
+    size_t count = monitor->pollBatch(0,collector);
+    testOk(count==capacity,"pollBatch returned %u expected %u",(unsigned)count,(unsigned)capacity);
+    PvaClientMonitorQueueStats stats(monitor->getQueueStats());
+    testOk(stats.maxQueued==capacity,"maxQueued %u",(unsigned)stats.maxQueued);
+    testOk(stats.dropped+stats.squashed==updates-capacity,
+        "dropped %u squashed %u",(unsigned)stats.dropped,(unsigned)stats.squashed);
+    monitor->stop();
+    return collector;
+}
+
+bool sameValues(Collector const & collector,double const * expected)
+{
+    if(collector.values.size()!=capacity) return false;
+    for(size_t i=0; i<capacity; ++i) {
+        if(collector.values[i]!=expected[i]) return false;
+    }
+    return true;
+}
+
+void testDropOldest(PvaClientChannelPtr const & pvaClientChannel,TestPvaClientServer & server)
+{
+    testDiag("testDropOldest");
+    Collector collector(fill(pvaClientChannel,server,PvaClientMonitor::dropOldest));
+    double expected[capacity] = {3.0,4.0,5.0};
+    testOk(sameValues(collector,expected),"the newest updates are kept");
+}
+
+void testDropNewest(PvaClientChannelPtr const & pvaClientChannel,TestPvaClientServer & server)
+{
+    testDiag("testDropNewest");
+    Collector collector(fill(pvaClientChannel,server,PvaClientMonitor::dropNewest));
+    double expected[capacity] = {0.0,1.0,2.0};
+    testOk(sameValues(collector,expected),"the oldest updates are kept");
+}
+
+void testSquash(PvaClientChannelPtr const & pvaClientChannel,TestPvaClientServer & server)
+{
+    testDiag("testSquash");
+    Collector collector(fill(pvaClientChannel,server,PvaClientMonitor::squash));
+    double expected[capacity] = {0.0,1.0,5.0};
+    testOk(sameValues(collector,expected),"later updates are merged into the newest");
+    testOk(collector.overrun.size()==capacity && !collector.overrun[0] && collector.overrun[2],
+        "only the merged update has overrun bits");
+}
+
+} // namespace
+
+MAIN(testPvaClientMonitorQueue)
+{
+    testPlan(3*5 + 1);
+    TestPvaClientServer server(providerName);
+    server.add(channelName);
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    PvaClientChannelPtr pvaClientChannel(pvaClient->channel(channelName,providerName));
+    testDropOldest(pvaClientChannel,server);
+    testDropNewest(pvaClientChannel,server);
+    testSquash(pvaClientChannel,server);
+    return testDone();
+}
@@ -0,0 +1,119 @@
+/* testPvaClientMonitorSelector.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <vector>
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include <pv/pvaClient.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientMonitorSelector";
+const char * channelNameA = "test:a";
+const char * channelNameB = "test:b";
+
+PvaClientMonitorPtr createMonitor(PvaClientPtr const & pvaClient,string const & channelName)
+{
+    PvaClientMonitorPtr monitor(
+        pvaClient->channel(channelName,providerName)->createMonitor("field(value)"));
+    monitor->connect();
+    monitor->start();
+    return monitor;
+}
+
+void drain(vector<PvaClientMonitorPtr> const & ready)
+{
+    for(size_t i=0; i<ready.size(); ++i) {
+        while(ready[i]->poll()) ready[i]->releaseEvent();
+    }
+}
+
+// a monitor is reported once for all the events since the previous wait
+void testReady(PvaClientPtr const & pvaClient,TestPvaClientServer & server)
+{
+    testDiag("testReady");
+    PvaClientMonitorSelectorPtr selector(PvaClientMonitorSelector::create());
+    PvaClientMonitorPtr monitorA(createMonitor(pvaClient,channelNameA));
+    PvaClientMonitorPtr monitorB(createMonitor(pvaClient,channelNameB));
+    selector->add(monitorA);
+    selector->add(monitorB);
+    testOk1(selector->getNumberMonitors()==2);
+    testOk1(selector->contains(monitorA) && selector->contains(monitorB));
+    try {
+        selector->add(monitorA);
+        testFail("add of a registered monitor did not throw");
+    } catch (std::runtime_error & e) {
+        testPass("add of a registered monitor throws: %s",e.what());
+    }
+    vector<PvaClientMonitorPtr> ready;
+    size_t count = selector->poll(ready);
+    testOk(count==2,"added monitors are ready, count %u",(unsigned)count);
+    drain(ready);
+    count = selector->wait(ready,0.1);
+    testOk(count==0,"wait without events timed out, count %u",(unsigned)count);
+    server.post(channelNameA,1.0);
+    server.post(channelNameA,2.0);
+    count = selector->wait(ready,5.0);
+    testOk(count==1 && ready[0]==monitorA,"one event of A is reported, count %u",(unsigned)count);
+    drain(ready);
+    count = selector->poll(ready);
+    testOk(count==0,"after the events are taken nothing is ready, count %u",(unsigned)count);
+}
+
+// remove, stop, and destroy all unregister a monitor
+void testRemove(PvaClientPtr const & pvaClient,TestPvaClientServer & server)
+{
+    testDiag("testRemove");
+    PvaClientMonitorSelectorPtr selector(PvaClientMonitorSelector::create());
+    PvaClientMonitorPtr monitorA(createMonitor(pvaClient,channelNameA));
+    PvaClientMonitorPtr monitorB(createMonitor(pvaClient,channelNameB));
+    selector->add(monitorA);
+    selector->add(monitorB);
+    selector->remove(monitorB);
+    testOk1(selector->getNumberMonitors()==1);
+    testOk1(!selector->contains(monitorB));
+    vector<PvaClientMonitorPtr> ready;
+    selector->poll(ready);
+    testOk(ready.size()==1 && ready[0]==monitorA,"a removed monitor is not ready");
+    drain(ready);
+    monitorA->stop();
+    testOk1(selector->getNumberMonitors()==0);
+    testOk1(!selector->contains(monitorA));
+    server.post(channelNameB,3.0);
+    testOk(selector->wait(ready,0.1)==0,"a removed monitor is not reported");
+    // a monitor can be registered again after it is removed
+    selector->add(monitorB);
+    testOk1(selector->getNumberMonitors()==1);
+    selector->poll(ready);
+    ready.clear();
+    monitorB.reset();
+    testOk1(selector->getNumberMonitors()==0);
+}
+
+} // namespace
+
+MAIN(testPvaClientMonitorSelector)
+{
+    testPlan(15);
+    TestPvaClientServer server(providerName);
+    server.add(channelNameA);
+    server.add(channelNameB);
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    testReady(pvaClient,server);
+    testRemove(pvaClient,server);
+    return testDone();
+}
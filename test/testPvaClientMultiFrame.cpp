@@ -0,0 +1,140 @@
+/* testPvaClientMultiFrame.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+
+#include <epicsUnitTest.h>
+#include <testMain.h>
+
+#include <pv/standardField.h>
+#include <pv/pvaClientMultiChannel.h>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+namespace {
+
+const char * providerName = "testPvaClientMultiFrame";
+const char * request = "field(value,timeStamp)";
+const size_t nchannel = 3;
+const char * channelName[nchannel] = {"test:a","test:b","test:c"};
+
+StructureConstPtr timeStampType()
+{
+    return getFieldCreate()->createFieldBuilder()
+        ->add("value",pvDouble)
+        ->add("timeStamp",getStandardField()->timeStamp())
+        ->createStructure();
+}
+
+void postTime(TestPvaClientServer & server,size_t index,int64 seconds,int32 userTag)
+{
+    PVStructurePtr value(server.getValue(channelName[index]));
+    PVStructurePtr pvTimeStamp(value->getSubFieldT<PVStructure>("timeStamp"));
+    pvTimeStamp->getSubFieldT<PVLong>("secondsPastEpoch")->put(seconds);
+    pvTimeStamp->getSubFieldT<PVInt>("nanoseconds")->put(0);
+    pvTimeStamp->getSubFieldT<PVInt>("userTag")->put(userTag);
+    PVDoublePtr pvValue(value->getSubFieldT<PVDouble>("value"));
+    pvValue->put(double(seconds));
+    BitSet changed;
+    changed.set(pvTimeStamp->getFieldOffset());
+    changed.set(pvValue->getFieldOffset());
+    server.post(channelName[index],changed);
+}
+
+PvaClientMultiFramePtr waitFrame(PvaClientMultiFrameBuilderPtr const & builder,double secondsToWait)
+{
+    if(!builder->waitFrame(secondsToWait)) return PvaClientMultiFramePtr();
+    return builder->getFrame();
+}
+
+// the first frame holds the value of each channel when its monitor started
+bool drainInitial(PvaClientMultiFrameBuilderPtr const & builder)
+{
+    builder->connect();
+    PvaClientMultiFramePtr frame(waitFrame(builder,5.0));
+    return frame && frame->getNumberPresent()==nchannel;
+}
+
+void testComplete(PvaClientMultiChannelPtr const & multiChannel,TestPvaClientServer & server)
+{
+    testDiag("testComplete");
+    PvaClientMultiFrameBuilderPtr builder(multiChannel->createFrameBuilder(request));
+    builder->setLimits(10,5.0);
+    testOk(drainInitial(builder),"initial frame is complete");
+    for(size_t i=0; i<nchannel; ++i) postTime(server,i,10,0);
+    PvaClientMultiFramePtr frame(waitFrame(builder,5.0));
+    testOk(frame.get()!=0,"frame is ready");
+    testOk(frame && frame->getNumberPresent()==nchannel,"all channels are present");
+    testOk(frame && frame->getSecondsPastEpoch()==10,"frame has the timeStamp of the updates");
+    testOk1(builder->getStats().complete==2);
+}
+
+// an incomplete frame ages out and is kept only if a quorum has reported
+void testQuorum(PvaClientMultiChannelPtr const & multiChannel,TestPvaClientServer & server)
+{
+    testDiag("testQuorum");
+    PvaClientMultiFrameBuilderPtr builder(multiChannel->createFrameBuilder(request));
+    builder->setQuorum(2);
+    builder->setLimits(10,0.2);
+    testOk(drainInitial(builder),"initial frame is complete");
+    postTime(server,0,20,0);
+    postTime(server,1,20,0);
+    PvaClientMultiFramePtr frame(waitFrame(builder,5.0));
+    testOk(frame.get()!=0,"partial frame is ready after it ages out");
+    testOk(frame && frame->getNumberPresent()==2 && !frame->getIsPresent()[2],
+        "the channel that did not report is not present");
+    // a late update does not start a frame that can never complete
+    postTime(server,2,20,0);
+    builder->waitFrame(0.3);
+    testOk1(builder->getStats().ignored==1);
+    postTime(server,0,30,0);
+    testOk(!builder->waitFrame(0.5),"a frame without a quorum is discarded");
+    PvaClientMultiFrameStats stats(builder->getStats());
+    testOk(stats.partial==1 && stats.incomplete==1,
+        "partial %u incomplete %u",(unsigned)stats.partial,(unsigned)stats.incomplete);
+}
+
+// updates with different timeStamps are grouped by userTag
+void testUserTag(PvaClientMultiChannelPtr const & multiChannel,TestPvaClientServer & server)
+{
+    testDiag("testUserTag");
+    PvaClientMultiFrameBuilderPtr builder(multiChannel->createFrameBuilder(request));
+    builder->setKeyType(PvaClientMultiFrameBuilder::userTagKey);
+    builder->setLimits(10,5.0);
+    testOk(drainInitial(builder),"initial frame is complete");
+    for(size_t i=0; i<nchannel; ++i) postTime(server,i,40+i,7);
+    PvaClientMultiFramePtr frame(waitFrame(builder,5.0));
+    testOk(frame.get()!=0,"frame is ready");
+    testOk(frame && frame->getNumberPresent()==nchannel && frame->getUserTag()==7,
+        "one frame for userTag 7");
+}
+
+} // namespace
+
+MAIN(testPvaClientMultiFrame)
+{
+    testPlan(14);
+    TestPvaClientServer server(providerName);
+    shared_vector<string> names(nchannel);
+    for(size_t i=0; i<nchannel; ++i) {
+        server.add(channelName[i],timeStampType());
+        names[i] = channelName[i];
+    }
+
+    PvaClientPtr pvaClient(server.getPvaClient());
+    PvaClientMultiChannelPtr multiChannel(
+        PvaClientMultiChannel::create(pvaClient,freeze(names),providerName));
+    Status status(multiChannel->connect());
+    testDiag("connect %s",status.getMessage().c_str());
+    testComplete(multiChannel,server);
+    testQuorum(multiChannel,server);
+    testUserTag(multiChannel,server);
+    return testDone();
+}
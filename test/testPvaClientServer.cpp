@@ -0,0 +1,101 @@
+/* testPvaClientServer.cpp */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+
+#include <stdexcept>
+
+#include "testPvaClientServer.h"
+
+using namespace epics::pvData;
+using namespace epics::pvAccess;
+using namespace epics::pvaClient;
+using namespace std;
+
+TestPvaClientServer::TestPvaClientServer(string const & providerName)
+: providerName(providerName),
+  provider(providerName)
+{
+    ChannelProviderRegistry::clients()->addSingleton(provider.provider());
+}
+
+TestPvaClientServer::~TestPvaClientServer()
+{
+    for(map<string,Entry>::iterator iter=entries.begin(); iter!=entries.end(); ++iter) {
+        iter->second.pv->close();
+    }
+}
+
+StructureConstPtr TestPvaClientServer::doubleType()
+{
+    return getFieldCreate()->createFieldBuilder()
+        ->add("value",pvDouble)
+        ->createStructure();
+}
+
+void TestPvaClientServer::add(
+    string const & channelName,
+    StructureConstPtr const & type,
+    bool mailbox)
+{
+    Entry entry;
+    entry.pv = (mailbox ? pvas::SharedPV::buildMailbox() : pvas::SharedPV::buildReadOnly());
+    entry.value = getPVDataCreate()->createPVStructure(type);
+    entry.pv->open(*entry.value);
+    provider.add(channelName,entry.pv);
+    entries[channelName] = entry;
+}
+
+TestPvaClientServer::Entry & TestPvaClientServer::find(string const & channelName)
+{
+    map<string,Entry>::iterator iter = entries.find(channelName);
+    if(iter==entries.end()) {
+        throw std::runtime_error("TestPvaClientServer no PV " + channelName);
+    }
+    return iter->second;
+}
+
+PVStructurePtr TestPvaClientServer::getValue(string const & channelName)
+{
+    return find(channelName).value;
+}
+
+void TestPvaClientServer::post(string const & channelName,BitSet const & changed)
+{
+    Entry & entry(find(channelName));
+    entry.pv->post(*entry.value,changed);
+}
+
+void TestPvaClientServer::post(string const & channelName,string const & fieldName,double x)
+{
+    Entry & entry(find(channelName));
+    PVScalarPtr pvScalar(entry.value->getSubFieldT<PVScalar>(fieldName));
+    pvScalar->putFrom<double>(x);
+    BitSet changed;
+    changed.set(pvScalar->getFieldOffset());
+    entry.pv->post(*entry.value,changed);
+}
+
+void TestPvaClientServer::post(string const & channelName,double x)
+{
+    post(channelName,"value",x);
+}
+
+PVStructurePtr TestPvaClientServer::fetch(string const & channelName)
+{
+    Entry & entry(find(channelName));
+    PVStructurePtr value(getPVDataCreate()->createPVStructure(entry.value->getStructure()));
+    BitSet valid;
+    entry.pv->fetch(*value,valid);
+    return value;
+}
+
+PvaClientPtr TestPvaClientServer::getPvaClient()
+{
+    return PvaClient::get(providerName);
+}
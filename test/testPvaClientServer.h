@@ -0,0 +1,89 @@
+/* testPvaClientServer.h */
+/**
+ * Copyright - See the COPYRIGHT that is included with this distribution.
+ * EPICS pvData is distributed subject to a Software License Agreement found
+ * in file LICENSE that is included with this distribution.
+ */
+/**
+ * @date 2026.10
+ */
+#ifndef TESTPVACLIENTSERVER_H
+#define TESTPVACLIENTSERVER_H
+
+#include <map>
+#include <string>
+
+#include <pv/pvas.h>
+#include <pv/pvaClient.h>
+
+/**
+ * @brief A local provider that serves the PVs of a test.
+ *
+ * The provider is registered with the client provider registry
+ * so that PvaClient::get(providerName) finds it.
+ * All PVs are closed when the server is destroyed.
+ */
+class TestPvaClientServer
+{
+public:
+    /** @brief Create and register the provider.
+     * @param providerName The name of the provider.
+     */
+    explicit TestPvaClientServer(std::string const & providerName);
+    ~TestPvaClientServer();
+    /** @brief A structure with a double value field.
+     * @return The introspection interface.
+     */
+    static epics::pvData::StructureConstPtr doubleType();
+    /** @brief Add a PV.
+     * @param channelName The channel name.
+     * @param type The type of the PV.
+     * @param mailbox Accept puts if true, else the PV is read only.
+     */
+    void add(
+        std::string const & channelName,
+        epics::pvData::StructureConstPtr const & type = doubleType(),
+        bool mailbox = false);
+    /** @brief Get the value that post sends.
+     * @param channelName The channel name.
+     * @return The value.
+     */
+    epics::pvData::PVStructurePtr getValue(std::string const & channelName);
+    /** @brief Post the value with the given fields marked as changed.
+     * @param channelName The channel name.
+     * @param changed The changed fields.
+     */
+    void post(std::string const & channelName,epics::pvData::BitSet const & changed);
+    /** @brief Set a scalar field and post it.
+     * @param channelName The channel name.
+     * @param fieldName The name of the scalar field.
+     * @param x The new value.
+     */
+    void post(std::string const & channelName,std::string const & fieldName,double x);
+    /** @brief Set the value field and post it.
+     * @param channelName The channel name.
+     * @param x The new value.
+     */
+    void post(std::string const & channelName,double x);
+    /** @brief Get the value the PV holds now, including puts from clients.
+     * @param channelName The channel name.
+     * @return A copy of the value.
+     */
+    epics::pvData::PVStructurePtr fetch(std::string const & channelName);
+    /** @brief Get the pvaClient that uses the provider.
+     * @return The pvaClient.
+     */
+    epics::pvaClient::PvaClientPtr getPvaClient();
+private:
+    struct Entry {
+        pvas::SharedPV::shared_pointer pv;
+        epics::pvData::PVStructurePtr value;
+    };
+    Entry & find(std::string const & channelName);
+
+    std::string providerName;
+    pvas::StaticProvider provider;
+    std::map<std::string,Entry> entries;
+};
+
+#endif  /* TESTPVACLIENTSERVER_H */